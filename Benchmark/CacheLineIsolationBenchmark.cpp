@@ -0,0 +1,179 @@
+/*
+Cache line isolated layout microbenchmark.
+
+Author: The Iron Wolf (vleonavicius@hotmail.com)
+Website: thecrewchief.org
+
+Description:
+  Measures cost of the Telemetry-like update done by the writer while N reader threads poll the version block,
+  for the regular and the cache line isolated layouts (see rF2MappedBufferLayout).
+
+  In the regular layout, version block shares the cache line with mBytesUpdatedHint, mNumVehicles and the first
+  vehicle, so each of those writes invalidates the line in every polling core, and the writer has to win it back.
+  In the cache line isolated layout, only BeginUpdate/EndUpdate touch the polled line.
+
+  This is not a part of the Plugin build.  To build and run:
+    Windows: cl /O2 /EHsc /I..\Include CacheLineIsolationBenchmark.cpp && CacheLineIsolationBenchmark.exe [maxPollers] [millisPerRun]
+    Linux:   g++ -O2 -std=c++11 -pthread -I../Include CacheLineIsolationBenchmark.cpp -lrt && ./a.out [maxPollers] [millisPerRun]
+
+  Results are only meaningful on a machine with more cores than maxPollers + 1.
+*/
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <assert.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Minimal stand-ins for the Plugin types MappedBuffer<> depends on.
+enum class DebugLevel : long
+{
+  Errors = 1,
+  Warnings = 8,
+  Synchronization = 16
+};
+
+enum class DebugSource : long
+{
+  General = 1,
+  MappedBufferSource = 4
+};
+
+class SharedMemoryPlugin
+{
+public:
+  static void WriteDebugMsg(DebugLevel lvl, DebugSource, char const* const functionName, int line, char const* const msg, ...)
+  {
+    if (lvl != DebugLevel::Errors)
+      return;
+
+    va_list argList;
+    va_start(argList, msg);
+    fprintf(stderr, "%s(%d): ", functionName, line);
+    vfprintf(stderr, msg, argList);
+    fprintf(stderr, "\n");
+    va_end(argList);
+  }
+
+  static void TraceLastWin32Error() { fprintf(stderr, "OS error.\n"); }
+
+  static long msDebugOutputLevel;
+};
+
+long SharedMemoryPlugin::msDebugOutputLevel = 0L;
+
+#define DEBUG_MSG(lvl, src, msg, ...) SharedMemoryPlugin::WriteDebugMsg(lvl, src, __FUNCTION__, __LINE__, msg, ##__VA_ARGS__)
+
+#include "rF2State.h"
+#include "MappedBuffer.h"
+
+namespace
+{
+
+int const NUM_VEHICLES = 20;
+
+struct RunResult
+{
+  double mNanosPerUpdate;
+  double mPolledUpdatesPerReader;
+};
+
+RunResult Run(bool cacheLineIsolated, int numPollers, int millisPerRun)
+{
+  MappedBuffer<rF2Telemetry> telemetry("$rFactor2SMMP_CacheLineIsolationBenchmark$");
+  if (!telemetry.Initialize(false /*mapGlobally*/, false /*tripleBuffered*/, false /*notifyUpdates*/, cacheLineIsolated)) {
+    fprintf(stderr, "Failed to map the buffer.\n");
+    exit(1);
+  }
+
+  std::atomic<bool> stop(false);
+  std::atomic<long long> polledUpdates(0LL);
+  auto const pVersionBlock = telemetry.mpWriteBuffVersionBlock;
+
+  std::vector<std::thread> pollers;
+  for (int i = 0; i < numPollers; ++i) {
+    pollers.emplace_back([&]() {
+      auto const pBegin = static_cast<unsigned long volatile*>(&pVersionBlock->mVersionUpdateBegin);
+      auto const pEnd = static_cast<unsigned long volatile*>(&pVersionBlock->mVersionUpdateEnd);
+      auto lastSeen = 0uL;
+      auto seen = 0LL;
+      while (!stop.load(std::memory_order_relaxed)) {
+        auto const versionBegin = *pBegin;
+        if (versionBegin == *pEnd && versionBegin != lastSeen) {
+          lastSeen = versionBegin;
+          ++seen;
+        }
+      }
+
+      polledUpdates += seen;
+    });
+  }
+
+  auto const start = std::chrono::high_resolution_clock::now();
+  auto const deadline = start + std::chrono::milliseconds(millisPerRun);
+  auto numUpdates = 0LL;
+  auto now = start;
+  while (now < deadline) {
+    // Batch updates, so that clock reads do not dominate.
+    for (int batch = 0; batch < 256; ++batch, ++numUpdates) {
+      telemetry.BeginUpdate();
+
+      auto const pBuff = telemetry.mpWriteBuff;
+      pBuff->mNumVehicles = NUM_VEHICLES;
+      for (int i = 0; i < NUM_VEHICLES; ++i) {
+        auto& veh = pBuff->mVehicles[i];
+        veh.mID = i;
+        veh.mDeltaTime = 0.01;
+        veh.mElapsedTime = numUpdates * 0.01;
+        veh.mPos.x = static_cast<double>(numUpdates + i);
+      }
+
+      pBuff->mBytesUpdatedHint = static_cast<int>(reinterpret_cast<char*>(&pBuff->mVehicles[NUM_VEHICLES]) - reinterpret_cast<char*>(pBuff));
+      telemetry.EndUpdate();
+    }
+
+    now = std::chrono::high_resolution_clock::now();
+  }
+
+  stop = true;
+  for (auto& poller : pollers)
+    poller.join();
+
+  auto const elapsedNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count();
+
+  RunResult result = {};
+  result.mNanosPerUpdate = static_cast<double>(elapsedNanos) / static_cast<double>(numUpdates);
+  result.mPolledUpdatesPerReader = numPollers > 0 ? static_cast<double>(polledUpdates.load()) / numPollers / numUpdates : 0.0;
+
+  return result;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+  auto const maxPollers = argc > 1 ? atoi(argv[1]) : 8;
+  auto const millisPerRun = argc > 2 ? atoi(argv[2]) : 1000;
+
+  printf("Hardware threads: %u\n", std::thread::hardware_concurrency());
+  printf("%8s  %22s  %22s  %8s\n", "pollers", "regular ns/update", "isolated ns/update", "speedup");
+
+  for (int numPollers = 0; numPollers <= maxPollers; numPollers = numPollers == 0 ? 1 : numPollers * 2) {
+    auto const regular = Run(false /*cacheLineIsolated*/, numPollers, millisPerRun);
+    auto const isolated = Run(true /*cacheLineIsolated*/, numPollers, millisPerRun);
+
+    printf("%8d  %12.1f (%5.1f%% seen)  %12.1f (%5.1f%% seen)  %7.2fx\n", numPollers,
+      regular.mNanosPerUpdate, regular.mPolledUpdatesPerReader * 100.0,
+      isolated.mNanosPerUpdate, isolated.mPolledUpdatesPerReader * 100.0,
+      regular.mNanosPerUpdate / isolated.mNanosPerUpdate);
+  }
+
+  return 0;
+}
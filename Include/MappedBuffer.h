@@ -14,10 +14,102 @@ Description:
 
   MappedBuffer<> client code has to call BeginUpdate before updating buffer (mpBuff) contents and
   EndUpdate once they're done.
+
+  Mapping and atomic operations on the version block are done via MappedBufferPlatform layer (Win32 or POSIX).
+
+  Optionally, EndUpdate signals completed update to the readers blocked in MappedBufferPlatform::WaitForUpdate
+  (see MappedBufferPlatform.h for details).
+
+  Optionally, write buffer can be mapped in the triple buffered layout.  In that case, rF2MappedBufferVersionBlock
+  is followed by rF2MappedBufferSlotBlock and rF2MappedBufferSlotBlock::NUM_SLOTS copies of BuffT.  BeginUpdate
+  points mpWriteBuff at the slot following the published one, and EndUpdate flips mPublishedSlot to it.  Between
+  updates mpWriteBuff points at the published slot, so plugin code reading back last written values keeps working.
+  Note that slot contents are not carried over between updates, so each update has to write everything it
+  covers via mBytesUpdatedHint (which all of the current writers do).
+
+  Optionally, buffer can be mapped in the cache line isolated layout, where the header (version block and slot block)
+  takes rF2MappedBufferLayout::HEADER_SIZE bytes and triple buffered slots start on the cache line boundary.  Otherwise,
+  first bytes of BuffT share the cache line with the version block, so every write to them invalidates that line in the
+  cores of all the readers polling the version block, and stalls the writer on getting it back.
+
+  ClearState only clears the bytes that were written since the last clear.  High-water mark of the written bytes is tracked
+  on EndUpdate using mBytesUpdatedHint (see GetBytesWritten overloads below), so clearing buffer that held 20 vehicles
+  does not memset all of the rF2MappedBufferHeader::MAX_MAPPED_VEHICLES entries.
+
+  Optionally, mapping can be backed by large pages (see MappedBufferPlatform.h).  Layout does not change, but mapped size
+  is rounded up to the large page size.  If large pages are not available, buffer is mapped with the regular pages.
+
+  Write buffer mapping ends with rF2MappedBufferPublishStamp, which EndUpdate fills in before bumping mVersionUpdateEnd.
+  Each update is also accounted for in rF2BufferStatistics (see GetStatistics), which the plugin publishes in the
+  Statistics buffer.  Update duration is the time plugin spent writing the update.  Updates written over several game
+  callbacks (Telemetry frame assembly) call PauseUpdateTiming/ResumeUpdateTiming, so that the time game spends between
+  the callbacks is not counted.
 */
 #pragma once
-#include <sddl.h>
+#include <algorithm>                            // std::min, std::max (min/max macros only come with windows.h)
+
 #include "Utils.h"
+#include "MappedBufferPlatform.h"
+
+// How many leading bytes of the buffer last update could have written.  By default, whole buffer.
+inline size_t GetBytesWritten(rF2MappedBufferHeader const&, size_t buffSize)
+{
+  return buffSize;
+}
+
+inline size_t GetBytesWritten(rF2MappedBufferHeaderWithSize const& buff, size_t buffSize)
+{
+  // 0 means unknown.
+  return buff.mBytesUpdatedHint > 0 ? (std::min)(static_cast<size_t>(buff.mBytesUpdatedHint), buffSize) : buffSize;
+}
+
+inline size_t GetBytesWritten(rF2TelemetryHistory const& buff, size_t buffSize)
+{
+  // Vehicle pool fills up from the start, and wraps around once full.
+  auto const numVehicles = (std::min)(buff.mVehiclesWritten, static_cast<unsigned long>(rF2TelemetryHistory::MAX_VEHICLE_SLOTS));
+  return (std::min)(offsetof(rF2TelemetryHistory, mVehicles) + numVehicles * sizeof(rF2VehicleTelemetry), buffSize);
+}
+
+// Bytes at the end of the buffer that are written on every update, but are not covered by mBytesUpdatedHint.
+inline size_t GetTrailingBytesWritten(rF2MappedBufferHeader const&)
+{
+  return 0u;
+}
+
+inline size_t GetTrailingBytesWritten(rF2Telemetry const&)
+{
+  return sizeof(rF2Telemetry) - offsetof(rF2Telemetry, mVehicleChangedBits);
+}
+
+inline size_t GetTrailingBytesWritten(rF2Scoring const&)
+{
+  return sizeof(rF2Scoring) - offsetof(rF2Scoring, mVehicleChangedBits);
+}
+
+// Restores the trailing fields whose empty state is not all zeroes, after buffer was zeroed out.
+inline void InitClearedTrailingBytes(rF2MappedBufferHeader&)
+{
+}
+
+inline void InitClearedTrailingBytes(rF2Telemetry& buff)
+{
+  memset(buff.mVehicleIDIndex.mIDs, -1, sizeof(buff.mVehicleIDIndex.mIDs));
+}
+
+inline void InitClearedTrailingBytes(rF2Scoring& buff)
+{
+  memset(buff.mVehicleIDIndex.mIDs, -1, sizeof(buff.mVehicleIDIndex.mIDs));
+}
+
+// Log2 microsecond bucket, see rF2BufferStatistics.
+inline int GetStatisticsHistogramBucket(double microseconds)
+{
+  auto bucket = 0;
+  for (auto bound = 1.0; microseconds >= bound && bucket < rF2BufferStatistics::NUM_HISTOGRAM_BUCKETS - 1; bound *= 2.0)
+    ++bucket;
+
+  return bucket;
+}
 
 template <typename BuffT>
 class MappedBuffer
@@ -43,11 +135,44 @@ public:
     ReleaseResources();
   }
 
-  bool Initialize(bool mapGlobally)
+  bool Initialize(bool mapGlobally, bool tripleBuffered = false, bool notifyUpdates = false, bool cacheLineIsolated = false, bool largePages = false)
   {
+    static_assert(sizeof(rF2MappedBufferVersionBlock) + sizeof(rF2MappedBufferSlotBlock) <= rF2MappedBufferLayout::HEADER_SIZE,
+      "Buffer header does not fit rF2MappedBufferLayout::HEADER_SIZE");
+
     assert(!mMapped);
+    assert(!tripleBuffered || READ_BUFFER_SUPPORTED_LAYOUT_VERSION == 0L);
+    assert(!notifyUpdates || READ_BUFFER_SUPPORTED_LAYOUT_VERSION == 0L);
+    assert(!cacheLineIsolated || READ_BUFFER_SUPPORTED_LAYOUT_VERSION == 0L);
+
+    mNotifyUpdatesRequested = notifyUpdates;
+    mCacheLineIsolated = cacheLineIsolated;
+    mLargePagesRequested = largePages;
+    mLargePages = false;
+
+    mNumSlots = tripleBuffered ? rF2MappedBufferSlotBlock::NUM_SLOTS : 1;
+    if (cacheLineIsolated) {
+      size_t const lineSize = rF2MappedBufferLayout::CACHE_LINE_SIZE;
+      mHeaderSize = rF2MappedBufferLayout::HEADER_SIZE;
+      mSlotStride = tripleBuffered ? (sizeof(BuffT) + lineSize - 1u) / lineSize * lineSize : sizeof(BuffT);
+    }
+    else {
+      mHeaderSize = sizeof(rF2MappedBufferVersionBlock) + (tripleBuffered ? sizeof(rF2MappedBufferSlotBlock) : 0);
+      mSlotStride = sizeof(BuffT);
+    }
+
+    mMappedSize = mHeaderSize + mNumSlots * mSlotStride;
+    if (READ_BUFFER_SUPPORTED_LAYOUT_VERSION == 0L)
+      mMappedSize += sizeof(rF2MappedBufferPublishStamp);
+
+    mBytesWrittenHighWaterMark = 0u;
+
+    memset(&mStatistics, 0, sizeof(rF2BufferStatistics));
+    mStatistics.mLastPublishElapsedTime = -1.0;
+    mTicksPerMicrosecond = static_cast<double>(MappedBufferPlatform::GetTimestampFrequency()) / 1000000.0;
+
     mhMap = MapMemoryFile(MM_FILE_NAME, mapGlobally, mpMappedView, mpWriteBuffVersionBlock, mpWriteBuff);
-    if (mhMap == nullptr) {
+    if (mhMap == MappedBufferPlatform::INVALID_MAP_HANDLE) {
       DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "Failed to map file");
       ReleaseResources();
 
@@ -59,7 +184,16 @@ public:
     assert(mpWriteBuff != nullptr);
 
     // Minimal risk here that this will get accessed before mMapped == true, but who cares.
-    memset(mpMappedView, 0, sizeof(rF2MappedBufferVersionBlock) + sizeof(BuffT));
+    memset(mpMappedView, 0, mMappedSize);
+
+    if (mpSlotBlock != nullptr) {
+      mpSlots = mpWriteBuff;
+      mWriteSlot = mpSlotBlock->mPublishedSlot = 0uL;
+    }
+
+    // mpWriteBuff points at the first slot here.
+    for (auto slot = 0uL; slot < mNumSlots; ++slot)
+      InitClearedTrailingBytes(*reinterpret_cast<BuffT*>(reinterpret_cast<char*>(mpWriteBuff) + slot * mSlotStride));
 
     mMapped = true;
 
@@ -84,13 +218,26 @@ public:
         DEBUG_MSG(DebugLevel::Synchronization, DebugSource::MappedBufferSource, "BeginUpdate: versions out of sync.  Version Begin:%ld  End:%ld",
           mpWriteBuffVersionBlock->mVersionUpdateBegin, mpWriteBuffVersionBlock->mVersionUpdateEnd);
       }
-      ::InterlockedExchange(&mpWriteBuffVersionBlock->mVersionUpdateEnd, mpWriteBuffVersionBlock->mVersionUpdateBegin);
+      MappedBufferPlatform::AtomicExchange(&mpWriteBuffVersionBlock->mVersionUpdateEnd, mpWriteBuffVersionBlock->mVersionUpdateBegin);
     }
 
-    ::InterlockedIncrement(&mpWriteBuffVersionBlock->mVersionUpdateBegin);
+    MappedBufferPlatform::AtomicIncrement(&mpWriteBuffVersionBlock->mVersionUpdateBegin);
+
+    mUpdateTicks = 0uLL;
+    mUpdateTimingSegmentBegin = MappedBufferPlatform::QueryTimestamp();
+    mUpdateTimingActive = true;
+
+    if (mpSlotBlock != nullptr) {
+      // Write into the slot that was published the longest time ago.  Mark it as being written to first,
+      // so that reader lapped by the writer can detect that.
+      mWriteSlot = (mpSlotBlock->mPublishedSlot + 1uL) % mNumSlots;
+      MappedBufferPlatform::AtomicExchange(&mpSlotBlock->mSlotVersions[mWriteSlot], 0uL);
+      mpWriteBuff = GetSlot(mWriteSlot);
+    }
   }
 
-  void EndUpdate()
+  // elapsedTime is the game ET of the data published, if applicable.
+  void EndUpdate(double elapsedTime = -1.0)
   {
     if (!mMapped) {
       DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "Accessing unmapped buffer.");
@@ -102,7 +249,23 @@ public:
       return;
     }
 
-    ::InterlockedIncrement(&mpWriteBuffVersionBlock->mVersionUpdateEnd);
+    if (mpSlotBlock != nullptr) {
+      // Stamp and publish the slot before bumping mVersionUpdateEnd, so that reader seeing matching versions
+      // always picks up this frame.
+      MappedBufferPlatform::AtomicExchange(&mpSlotBlock->mSlotVersions[mWriteSlot], mpWriteBuffVersionBlock->mVersionUpdateBegin);
+      MappedBufferPlatform::AtomicExchange(&mpSlotBlock->mPublishedSlot, mWriteSlot);
+    }
+
+    auto const publishTimestamp = MappedBufferPlatform::QueryTimestamp();
+    if (mpPublishStamp != nullptr) {
+      mpPublishStamp->mVersion = mpWriteBuffVersionBlock->mVersionUpdateBegin;
+      mpPublishStamp->mTimestamp = publishTimestamp;
+      mpPublishStamp->mElapsedTime = elapsedTime;
+    }
+
+    MappedBufferPlatform::AtomicIncrement(&mpWriteBuffVersionBlock->mVersionUpdateEnd);
+
+    UpdateStatistics(publishTimestamp, elapsedTime);
 
     // Fix up out of sync situation.
     if (mpWriteBuffVersionBlock->mVersionUpdateBegin != mpWriteBuffVersionBlock->mVersionUpdateEnd) {
@@ -110,8 +273,12 @@ public:
         DEBUG_MSG(DebugLevel::Synchronization, DebugSource::MappedBufferSource, "EndUpdate: versions out of sync.  Version Begin:%ld  End:%ld",
           mpWriteBuffVersionBlock->mVersionUpdateBegin, mpWriteBuffVersionBlock->mVersionUpdateEnd);
       }
-      ::InterlockedExchange(&mpWriteBuffVersionBlock->mVersionUpdateBegin, mpWriteBuffVersionBlock->mVersionUpdateEnd);
+      MappedBufferPlatform::AtomicExchange(&mpWriteBuffVersionBlock->mVersionUpdateBegin, mpWriteBuffVersionBlock->mVersionUpdateEnd);
     }
+
+    mBytesWrittenHighWaterMark = (std::max)(mBytesWrittenHighWaterMark, GetBytesWritten(*mpWriteBuff, sizeof(BuffT)));
+
+    MappedBufferPlatform::NotifyUpdate(mNotifier, &mpWriteBuffVersionBlock->mVersionUpdateEnd);
   }
 
   void ClearState(BuffT const* pInitialContents)
@@ -124,14 +291,29 @@ public:
       return;
     }
 
+    if (pInitialContents != nullptr) {
+      BeginUpdate();
+      memcpy(mpWriteBuff, pInitialContents, sizeof(BuffT));
+      EndUpdate();
+
+      return;
+    }
+
+    auto const bytesToClear = mBytesWrittenHighWaterMark;
+    auto const trailingBytes = GetTrailingBytesWritten(*mpWriteBuff);
+    assert(trailingBytes <= sizeof(BuffT));
+
     BeginUpdate();
 
-    if (pInitialContents != nullptr)
-      memcpy(mpWriteBuff, pInitialContents, sizeof(BuffT));
-    else
-      memset(mpWriteBuff, 0, sizeof(BuffT));
+    memset(mpWriteBuff, 0, bytesToClear);
+    memset(reinterpret_cast<char*>(mpWriteBuff) + sizeof(BuffT) - trailingBytes, 0, trailingBytes);
+    InitClearedTrailingBytes(*mpWriteBuff);
 
     EndUpdate();
+
+    // Cleared buffer has mBytesUpdatedHint of 0, which does not mean it was written to.  In the triple buffered
+    // layout, the other slots still hold the old contents, so the high-water mark has to be kept.
+    mBytesWrittenHighWaterMark = IsTripleBuffered() ? bytesToClear : 0u;
   }
 
   /////////////////////////////////////////////////////////////////
@@ -190,7 +372,7 @@ public:
 
     // Unmap view and close all handles.
     if (mpMappedView != nullptr
-      && !::UnmapViewOfFile(mpMappedView)) {
+      && !MappedBufferPlatform::UnmapView(mpMappedView, mMappedSize)) {
       DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "Failed to unmap mapped buffer view");
       SharedMemoryPlugin::TraceLastWin32Error();
     }
@@ -198,114 +380,175 @@ public:
     mpMappedView = nullptr;
     mpWriteBuff = nullptr;
     mpWriteBuffVersionBlock = nullptr;
+    mpSlotBlock = nullptr;
+    mpSlots = nullptr;
+    mpPublishStamp = nullptr;
+
+    MappedBufferPlatform::ReleaseUpdateNotifier(mNotifier);
 
     // Note: we didn't ever close this apparently before V3, oops.
-    if (mhMap != nullptr
-      && !::CloseHandle(mhMap)) {
+    if (mhMap != MappedBufferPlatform::INVALID_MAP_HANDLE
+      && !MappedBufferPlatform::CloseMapping(mhMap)) {
       DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "Failed to close mapped file handle.");
       SharedMemoryPlugin::TraceLastWin32Error();
     }
 
-    mhMap = nullptr;
+    mhMap = MappedBufferPlatform::INVALID_MAP_HANDLE;
+  }
+
+  // Last completed frame.  Same as mpWriteBuff, unless buffer is triple buffered and update is in progress.
+  BuffT const* GetPublishedBuff() const
+  {
+    return mpSlotBlock != nullptr ? GetSlot(mpSlotBlock->mPublishedSlot) : mpWriteBuff;
   }
 
+  // Stops counting update duration at the end of the callback, if the update continues in the next one.  No-op outside of update.
+  void PauseUpdateTiming()
+  {
+    if (!mUpdateTimingActive)
+      return;
+
+    mUpdateTicks += MappedBufferPlatform::QueryTimestamp() - mUpdateTimingSegmentBegin;
+    mUpdateTimingActive = false;
+  }
+
+  // Resumes counting update duration in the callback continuing the update.  No-op outside of update.
+  void ResumeUpdateTiming()
+  {
+    if (mUpdateTimingActive
+      || mpWriteBuffVersionBlock == nullptr
+      || mpWriteBuffVersionBlock->mVersionUpdateBegin == mpWriteBuffVersionBlock->mVersionUpdateEnd)
+      return;
+
+    mUpdateTimingSegmentBegin = MappedBufferPlatform::QueryTimestamp();
+    mUpdateTimingActive = true;
+  }
+
+  bool IsTripleBuffered() const { return mpSlotBlock != nullptr; }
+  bool IsUpdateNotified() const { return mNotifier.mActive; }
+  bool IsCacheLineIsolated() const { return mCacheLineIsolated; }
+  bool IsLargePages() const { return mLargePages; }
+  size_t GetMappedSize() const { return mMappedSize; }
+  rF2BufferStatistics const& GetStatistics() const { return mStatistics; }
+
 private:
   MappedBuffer(MappedBuffer const&) = delete;
   MappedBuffer& operator=(MappedBuffer const&) = delete;
 
-  HANDLE MapMemoryFile(char const* const fileName, bool dedicatedServerMapGlobally, LPVOID& pMappedView, rF2MappedBufferVersionBlock*& pBufVersionBlock, BuffT*& pBuf) const
+  void UpdateStatistics(unsigned long long publishTimestamp, double elapsedTime)
   {
-    char moduleName[1024] = {};
-    ::GetModuleFileNameA(nullptr, moduleName, sizeof(moduleName));
-
-    char mappingName[MAX_PATH] = {};
-    auto isDedicatedServer = false;
-    if (strstr(moduleName, "Dedicated.exe") == nullptr)
-      strcpy_s(mappingName, fileName);  // Regular client use.
-    else {
-      // Dedicated server use.  Append processId for dedicated server to allow multiple instances.
-      char pid[8] = {};
-      sprintf(pid, "%ld", ::GetCurrentProcessId());
+    if (mUpdateTimingActive) {
+      mUpdateTicks += publishTimestamp - mUpdateTimingSegmentBegin;
+      mUpdateTimingActive = false;
+    }
 
-      if (dedicatedServerMapGlobally)
-        sprintf(mappingName, "Global\\%s%s", fileName, pid);
-      else
-        sprintf(mappingName, "%s%s", fileName, pid);
+    auto const updateMicroseconds = static_cast<double>(mUpdateTicks) / mTicksPerMicrosecond;
+    ++mStatistics.mUpdateHistogram[GetStatisticsHistogramBucket(updateMicroseconds)];
+    mStatistics.mMaxUpdateMicroseconds = (std::max)(mStatistics.mMaxUpdateMicroseconds, updateMicroseconds);
 
-      isDedicatedServer = true;
+    // There's no interval before the first update.
+    if (mStatistics.mNumUpdates > 0uL) {
+      auto const intervalMicroseconds = static_cast<double>(publishTimestamp - mStatistics.mLastPublishTimestamp) / mTicksPerMicrosecond;
+      ++mStatistics.mIntervalHistogram[GetStatisticsHistogramBucket(intervalMicroseconds)];
+      mStatistics.mMaxIntervalMicroseconds = (std::max)(mStatistics.mMaxIntervalMicroseconds, intervalMicroseconds);
     }
 
-    HANDLE hMap = INVALID_HANDLE_VALUE;
-    if (!isDedicatedServer  // Regular client use.
-      || (isDedicatedServer && !dedicatedServerMapGlobally)) {  // Dedicated, but no global mapping requested.
-      // Init handle and try to create, read if existing.
-      hMap = ::CreateFileMappingA(
-        INVALID_HANDLE_VALUE,
-        nullptr  /*lpFileMappingAttributes*/,
-        PAGE_READWRITE,
-        0  /*dwMaximumSizeLow*/,
-        sizeof(rF2MappedBufferVersionBlock) + sizeof(BuffT),
-        mappingName);
-    }
-    else {
-      assert(isDedicatedServer);
-      assert(dedicatedServerMapGlobally);
+    ++mStatistics.mNumUpdates;
+    mStatistics.mLastPublishTimestamp = publishTimestamp;
+    mStatistics.mLastPublishElapsedTime = elapsedTime;
+  }
+
+  // Slots are mSlotStride bytes apart, which is larger than sizeof(BuffT) in the cache line isolated layout.
+  BuffT* GetSlot(unsigned long slot) const
+  {
+    return reinterpret_cast<BuffT*>(reinterpret_cast<char*>(mpSlots) + slot * mSlotStride);
+  }
+
+  // On success, mMappedSize is rounded up to the large page size.
+  MappedBufferPlatform::MapHandle MapLargePageMemoryFile(char const* const mappingName, bool mapGlobally, void*& pMappedView)
+  {
+    auto const largePageSize = MappedBufferPlatform::GetLargePageSize();
+    if (largePageSize == 0u)
+      return MappedBufferPlatform::INVALID_MAP_HANDLE;
+
+    auto const largePagesMappedSize = (mMappedSize + largePageSize - 1u) / largePageSize * largePageSize;
+
+    auto alreadyExists = false;
+    auto hMap = MappedBufferPlatform::CreateLargePageMapping(mappingName, largePagesMappedSize, mapGlobally, alreadyExists);
+    if (hMap == MappedBufferPlatform::INVALID_MAP_HANDLE)
+      return MappedBufferPlatform::INVALID_MAP_HANDLE;
+
+    if (alreadyExists)
+      DEBUG_MSG(DebugLevel::Warnings, DebugSource::General, "File mapping already exists for file: '%s'", mappingName);
 
-      SECURITY_ATTRIBUTES security = {};
-      security.nLength = sizeof(security);
+    // Large pages might be reserved, but not available at the moment, in which case this fails.
+    pMappedView = MappedBufferPlatform::MapView(hMap, largePagesMappedSize);
+    if (pMappedView == nullptr) {
+      MappedBufferPlatform::CloseMapping(hMap);
+      return MappedBufferPlatform::INVALID_MAP_HANDLE;
+    }
 
-      auto ret = ConvertStringSecurityDescriptorToSecurityDescriptor(
-        "D:P(A;OICI;GA;;;SY)(A;OICI;GA;;;BA)(A;OICI;GA;;;WD)",
-        SDDL_REVISION_1,
-        &security.lpSecurityDescriptor,
-        nullptr);
+    mMappedSize = largePagesMappedSize;
+    mLargePages = true;
 
-      auto onExit = Utils::MakeScopeGuard([&]() {
-        ::LocalFree(security.lpSecurityDescriptor);
-      });
+    return hMap;
+  }
 
-      if (!ret) {
-        DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "Failed to create security descriptor for mapping: '%s'", mappingName);
+  MappedBufferPlatform::MapHandle MapMemoryFile(char const* const fileName, bool dedicatedServerMapGlobally, void*& pMappedView, rF2MappedBufferVersionBlock*& pBufVersionBlock, BuffT*& pBuf)
+  {
+    char mappingName[MappedBufferPlatform::MAX_MAPPING_NAME_LEN] = {};
+    auto const mapGlobally = MappedBufferPlatform::BuildMappingName(fileName, dedicatedServerMapGlobally, mappingName);
+
+    auto alreadyExists = false;
+    auto hMap = MappedBufferPlatform::INVALID_MAP_HANDLE;
+    if (mLargePagesRequested) {
+      hMap = MapLargePageMemoryFile(mappingName, mapGlobally, pMappedView);
+      if (hMap == MappedBufferPlatform::INVALID_MAP_HANDLE) {
+        DEBUG_MSG(DebugLevel::Warnings, DebugSource::General, "Large pages are not available for file: '%s', falling back to regular pages.", mappingName);
         SharedMemoryPlugin::TraceLastWin32Error();
-        return nullptr;
       }
-
-      // Init handle and try to create, read if existing
-      hMap = ::CreateFileMappingA(
-        INVALID_HANDLE_VALUE,
-        &security,
-        PAGE_READWRITE,
-        0  /*dwMaximumSizeLow*/,
-        sizeof(rF2MappedBufferVersionBlock) + sizeof(BuffT),
-        mappingName);
     }
 
-    if (hMap == nullptr) {
+    if (hMap == MappedBufferPlatform::INVALID_MAP_HANDLE)
+      hMap = MappedBufferPlatform::CreateMapping(mappingName, mMappedSize, mapGlobally, alreadyExists);
+
+    if (hMap == MappedBufferPlatform::INVALID_MAP_HANDLE) {
       DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "Failed to create file mapping for file: '%s'", mappingName);
       SharedMemoryPlugin::TraceLastWin32Error();
-      return nullptr;
+      return MappedBufferPlatform::INVALID_MAP_HANDLE;
     }
 
-    if (::GetLastError() == ERROR_ALREADY_EXISTS)
+    if (alreadyExists)
       DEBUG_MSG(DebugLevel::Warnings, DebugSource::General, "File mapping already exists for file: '%s'", mappingName);
 
-    pMappedView = ::MapViewOfFile(
-      hMap,
-      FILE_MAP_ALL_ACCESS,
-      0 /*dwFileOffsetHigh*/,
-      0 /*dwFileOffsetLow*/,
-      sizeof(rF2MappedBufferVersionBlock) + sizeof(BuffT));
+    if (!mLargePages)
+      pMappedView = MappedBufferPlatform::MapView(hMap, mMappedSize);
 
     if (pMappedView == nullptr) {
       DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "Failed to map buffer view.");
       SharedMemoryPlugin::TraceLastWin32Error();
-      return nullptr;
+      MappedBufferPlatform::CloseMapping(hMap);
+      return MappedBufferPlatform::INVALID_MAP_HANDLE;
+    }
+
+    // Failure to create notification objects is not fatal, readers can still poll.
+    if (mNotifyUpdatesRequested
+      && !MappedBufferPlatform::CreateUpdateNotifier(mappingName, mapGlobally, mNotifier)) {
+      DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "Failed to create update notification for file: '%s'", mappingName);
+      SharedMemoryPlugin::TraceLastWin32Error();
+      MappedBufferPlatform::ReleaseUpdateNotifier(mNotifier);
     }
 
     // Set pointers up.
-    pBufVersionBlock = static_cast<rF2MappedBufferVersionBlock*>(mpMappedView);
-    pBuf = reinterpret_cast<BuffT*>(static_cast<char*>(pMappedView) + sizeof(rF2MappedBufferVersionBlock));
-    assert((reinterpret_cast<char*>(pBufVersionBlock) + sizeof(rF2MappedBufferVersionBlock)) == reinterpret_cast<char*>(pBuf));
+    pBufVersionBlock = static_cast<rF2MappedBufferVersionBlock*>(pMappedView);
+    if (mNumSlots > 1)
+      mpSlotBlock = reinterpret_cast<rF2MappedBufferSlotBlock*>(static_cast<char*>(pMappedView) + sizeof(rF2MappedBufferVersionBlock));
+
+    pBuf = reinterpret_cast<BuffT*>(static_cast<char*>(pMappedView) + mHeaderSize);
+    if (READ_BUFFER_SUPPORTED_LAYOUT_VERSION == 0L)
+      mpPublishStamp = reinterpret_cast<rF2MappedBufferPublishStamp*>(static_cast<char*>(pMappedView) + mHeaderSize + mNumSlots * mSlotStride);
+    assert(mCacheLineIsolated || mNumSlots > 1
+      || (reinterpret_cast<char*>(pBufVersionBlock) + sizeof(rF2MappedBufferVersionBlock)) == reinterpret_cast<char*>(pBuf));
 
     return hMap;
   }
@@ -325,10 +568,41 @@ private:
     unsigned long mReadLastVersionUpdateBegin = 0uL;
 
   private:
-    LPVOID mpMappedView = nullptr;
+    void* mpMappedView = nullptr;
     char const* const MM_FILE_NAME = nullptr;
-    HANDLE mhMap = nullptr;
+    MappedBufferPlatform::MapHandle mhMap = MappedBufferPlatform::INVALID_MAP_HANDLE;
     bool mMapped = false;
+    size_t mMappedSize = 0u;
+
+    // Triple buffered layout support.  mpSlotBlock is nullptr for the regular single buffer layout.
+    rF2MappedBufferSlotBlock* mpSlotBlock = nullptr;
+    BuffT* mpSlots = nullptr;
+    unsigned long mNumSlots = 1uL;
+    unsigned long mWriteSlot = 0uL;
+
+    // Update notification support.
+    bool mNotifyUpdatesRequested = false;
+    MappedBufferPlatform::UpdateNotifier mNotifier;
+
+    // Cache line isolated layout support.  mHeaderSize is the offset of the first slot from the mapped view start.
+    bool mCacheLineIsolated = false;
+    size_t mHeaderSize = sizeof(rF2MappedBufferVersionBlock);
+    size_t mSlotStride = sizeof(BuffT);
+
+    // High-water mark of the bytes written since the last ClearState.
+    size_t mBytesWrittenHighWaterMark = 0u;
+
+    // Large pages support.  mLargePages is false if large pages were requested, but were not available.
+    bool mLargePagesRequested = false;
+    bool mLargePages = false;
+
+    // Publish stamp and statistics support.  mpPublishStamp is nullptr for the read buffers.
+    rF2MappedBufferPublishStamp* mpPublishStamp = nullptr;
+    rF2BufferStatistics mStatistics = {};
+    unsigned long long mUpdateTicks = 0uLL;               // Update duration counted so far, see PauseUpdateTiming.
+    unsigned long long mUpdateTimingSegmentBegin = 0uLL;
+    bool mUpdateTimingActive = false;
+    double mTicksPerMicrosecond = 1.0;
 
     // If 0, it means this is write mode buffer.
     long const READ_BUFFER_SUPPORTED_LAYOUT_VERSION;
@@ -0,0 +1,645 @@
+/*
+Platform layer used by MappedBuffer<> class.
+
+Author: The Iron Wolf (vleonavicius@hotmail.com)
+Website: thecrewchief.org
+
+Description:
+  Abstracts named shared memory mapping and atomic operations on the version variables.  Only the shared memory layer
+  (this file, MappedBuffer<>, MappedBufferReader<> and rF2State.h) builds with the POSIX implementation, which is used
+  for benchmarking the publish path (see Benchmark/CacheLineIsolationBenchmark.cpp).  The Plugin translation unit
+  (rFactor2SharedMemoryMap.cpp) is Windows only (DMA, Win32 timers, CRT *_s functions).
+
+  Windows implementation is what the Plugin always used: CreateFileMappingA/MapViewOfFile and Interlocked* functions.
+  Dedicated server process PID is appended to the mapping name, and Global\ prefix is used if requested.
+
+  POSIX implementation uses shm_open/mmap.  Mapping names are prefixed with '/', so $rFactor2SMMP_Telemetry$ is
+  available as /dev/shm/$rFactor2SMMP_Telemetry$ on Linux.  Atomic operations use GCC/Clang __atomic builtins, because
+  std::atomic<> cannot be overlaid on the existing mapped layout (there's no std::atomic_ref before C++20).
+  Note: unlike Win32 mappings, POSIX shared memory objects persist until unlinked.  The Plugin does not unlink them,
+  so that consumers can keep reopening them between the Plugin restarts.
+
+  Optionally, buffer updates can be signaled to the readers, so that they can block instead of polling:
+    * On Windows, each buffer gets a pair of named manual-reset events: <mapping name>_Update0 and <mapping name>_Update1.
+      Once update is complete and mVersionUpdateEnd is V, event V % 2 is set and event (V + 1) % 2 is reset.
+      Reader that last saw version L waits on event (L + 1) % 2.  This wakes up all the waiting readers, and
+      reader that is late does not spin on the event it was already woken up by.
+    * On Linux, futex wait/wake is done directly on the (low 32 bits of) mVersionUpdateEnd, so no extra objects are needed.
+  In both cases, reader has to check mVersionUpdateEnd before waiting, and should wait with a timeout, because
+  reader that fell more than one update behind might miss the wake up.
+
+  Optionally, mapping can be backed by large pages, which cuts the TLB misses on the big buffers.  Mapping size
+  is rounded up to the large page size:
+    * On Windows, SEC_LARGE_PAGES section is created.  This requires "Lock pages in memory" (SeLockMemoryPrivilege)
+      user right, which the Plugin enables in the process token.  Mapping that already exists cannot be converted,
+      so it is opened with regular pages.
+    * On Linux, mapping is created as a file on the hugetlbfs mount at HUGETLBFS_DIR (shm_open cannot allocate huge
+      pages), for example /dev/hugepages/$rFactor2SMMP_Telemetry$.  Huge pages have to be reserved by the admin
+      (vm.nr_hugepages).  Readers look in HUGETLBFS_DIR first, and creating the mapping in one place removes the stale
+      one from the other place.
+  If large pages are not available, caller falls back to the regular mapping.
+
+  Publish timestamps (see rF2MappedBufferPublishStamp) come from QueryTimestamp, which is QueryPerformanceCounter on
+  Windows and CLOCK_MONOTONIC in nanoseconds on POSIX.
+
+  Note: mapped structures use long type, which is 4 bytes on Windows and 8 bytes on LP64 POSIX platforms.  So the
+  layout built on POSIX does not match the one published by the Plugin, and the POSIX mappings are only compatible with
+  the processes built from the same headers on the same platform.
+*/
+#pragma once
+
+#ifdef _WIN32
+#include <sddl.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/statfs.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+namespace MappedBufferPlatform
+{
+
+static int const MAX_MAPPING_NAME_LEN = 260;
+
+#ifdef _WIN32
+typedef HANDLE MapHandle;
+static MapHandle const INVALID_MAP_HANDLE = nullptr;
+#else
+typedef int MapHandle;
+static MapHandle const INVALID_MAP_HANDLE = -1;
+
+static char const* const HUGETLBFS_DIR = "/dev/hugepages";
+static long const HUGETLBFS_MAGIC_NUMBER = 0x958458f6L;
+#endif
+
+// Update notification state of a single buffer.
+struct UpdateNotifier
+{
+  UpdateNotifier()
+  {
+#ifdef _WIN32
+    mhEvents[0] = mhEvents[1] = nullptr;
+#endif
+  }
+
+  bool mActive = false;
+#ifdef _WIN32
+  HANDLE mhEvents[2];
+#endif
+};
+
+/////////////////////////////////////////////////////////////////
+// Atomic operations on the mapped version variables.
+
+inline void AtomicIncrement(unsigned long volatile* pValue)
+{
+#ifdef _WIN32
+  ::InterlockedIncrement(pValue);
+#else
+  __atomic_add_fetch(pValue, 1uL, __ATOMIC_SEQ_CST);
+#endif
+}
+
+// Returns the initial value of *pValue.
+inline unsigned long AtomicExchange(unsigned long volatile* pValue, unsigned long value)
+{
+#ifdef _WIN32
+  return ::InterlockedExchange(pValue, value);
+#else
+  return __atomic_exchange_n(pValue, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+// Returns the initial value of *pValue.  Exchange happens only if it equals comparand.
+inline unsigned long AtomicCompareExchange(unsigned long volatile* pValue, unsigned long exchange, unsigned long comparand)
+{
+#ifdef _WIN32
+  return ::InterlockedCompareExchange(pValue, exchange, comparand);
+#else
+  return __sync_val_compare_and_swap(pValue, comparand, exchange);
+#endif
+}
+
+// Load with acquire semantics: later reads of the buffer cannot move before it.
+inline unsigned long AtomicLoad(unsigned long const volatile* pValue)
+{
+#ifdef _WIN32
+  // MSVC volatile reads have acquire semantics on x86/x64 (/volatile:ms is the default there).
+  return *pValue;
+#else
+  return __atomic_load_n(pValue, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/////////////////////////////////////////////////////////////////
+// Publish timestamps.
+
+// Monotonic timestamp, comparable between the processes: QueryPerformanceCounter on Windows, CLOCK_MONOTONIC nanoseconds on POSIX.
+inline unsigned long long QueryTimestamp()
+{
+#ifdef _WIN32
+  LARGE_INTEGER now = {};
+  QueryPerformanceCounter(&now);
+  return static_cast<unsigned long long>(now.QuadPart);
+#else
+  timespec now = {};
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<unsigned long long>(now.tv_sec) * 1000000000uLL + static_cast<unsigned long long>(now.tv_nsec);
+#endif
+}
+
+// QueryTimestamp ticks per second.
+inline unsigned long long GetTimestampFrequency()
+{
+#ifdef _WIN32
+  LARGE_INTEGER frequency = {};
+  QueryPerformanceFrequency(&frequency);
+  return static_cast<unsigned long long>(frequency.QuadPart);
+#else
+  return 1000000000uLL;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////
+// Named shared memory mapping.
+
+// Builds the mapping name out of the buffer file name.  Returns true if mapping has to be created in the Global namespace.
+inline bool BuildMappingName(char const* const fileName, bool dedicatedServerMapGlobally, char (&mappingName)[MAX_MAPPING_NAME_LEN])
+{
+#ifdef _WIN32
+  char moduleName[1024] = {};
+  ::GetModuleFileNameA(nullptr, moduleName, sizeof(moduleName));
+
+  if (strstr(moduleName, "Dedicated.exe") == nullptr) {
+    strcpy_s(mappingName, fileName);  // Regular client use.
+    return false;
+  }
+
+  // Dedicated server use.  Append processId for dedicated server to allow multiple instances.
+  char pid[8] = {};
+  sprintf(pid, "%ld", ::GetCurrentProcessId());
+
+  if (dedicatedServerMapGlobally)
+    sprintf(mappingName, "Global\\%s%s", fileName, pid);
+  else
+    sprintf(mappingName, "%s%s", fileName, pid);
+
+  return dedicatedServerMapGlobally;
+#else
+  // There's no dedicated server build for POSIX platforms.
+  (void)dedicatedServerMapGlobally;
+  snprintf(mappingName, sizeof(mappingName), "/%s", fileName);
+
+  return false;
+#endif
+}
+
+#ifdef _WIN32
+// Global objects have to be accessible by the clients running under different accounts.  Caller has to LocalFree lpSecurityDescriptor.
+inline bool InitGlobalSecurityAttributes(SECURITY_ATTRIBUTES& security)
+{
+  security.nLength = sizeof(security);
+
+  return ConvertStringSecurityDescriptorToSecurityDescriptor(
+    "D:P(A;OICI;GA;;;SY)(A;OICI;GA;;;BA)(A;OICI;GA;;;WD)",
+    SDDL_REVISION_1,
+    &security.lpSecurityDescriptor,
+    nullptr) != FALSE;
+}
+#endif
+
+#ifndef _WIN32
+// Path of the mapping on the hugetlbfs mount.  mappingName already starts with '/'.
+inline bool BuildLargePagePath(char const* const mappingName, char (&path)[MAX_MAPPING_NAME_LEN])
+{
+  auto const len = snprintf(path, sizeof(path), "%s%s", HUGETLBFS_DIR, mappingName);
+  return len > 0 && len < static_cast<int>(sizeof(path));
+}
+#endif
+
+// Returns large page size, or 0 if large pages are not available.
+inline size_t GetLargePageSize()
+{
+#ifdef _WIN32
+  return ::GetLargePageMinimum();
+#elif defined(__linux__)
+  struct statfs st = {};
+  if (::statfs(HUGETLBFS_DIR, &st) != 0
+    || static_cast<long>(st.f_type) != HUGETLBFS_MAGIC_NUMBER
+    || st.f_bsize <= 0)
+    return 0u;
+
+  return static_cast<size_t>(st.f_bsize);
+#else
+  return 0u;
+#endif
+}
+
+#ifdef _WIN32
+// Enables "Lock pages in memory" privilege, which is required for SEC_LARGE_PAGES.  It has to be granted to the account first.
+inline bool EnableLockMemoryPrivilege()
+{
+  HANDLE hToken = nullptr;
+  if (!::OpenProcessToken(::GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &hToken))
+    return false;
+
+  auto onExit = Utils::MakeScopeGuard([&]() {
+    ::CloseHandle(hToken);
+  });
+
+  TOKEN_PRIVILEGES privileges = {};
+  privileges.PrivilegeCount = 1;
+  privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+  if (!::LookupPrivilegeValueA(nullptr, "SeLockMemoryPrivilege", &privileges.Privileges[0].Luid))
+    return false;
+
+  // AdjustTokenPrivileges succeeds even if privilege is not granted, in which case it sets ERROR_NOT_ALL_ASSIGNED.
+  return ::AdjustTokenPrivileges(hToken, FALSE /*DisableAllPrivileges*/, &privileges, 0 /*BufferLength*/, nullptr, nullptr) != FALSE
+    && ::GetLastError() == ERROR_SUCCESS;
+}
+#endif
+
+// Creates the mapping backed by large pages.  size has to be a multiple of GetLargePageSize().  Returns INVALID_MAP_HANDLE
+// if large pages cannot be used, in which case caller should fall back to CreateMapping.
+inline MapHandle CreateLargePageMapping(char const* const mappingName, size_t size, bool mapGlobally, bool& alreadyExists)
+{
+  alreadyExists = false;
+
+#ifdef _WIN32
+  if (!EnableLockMemoryPrivilege())
+    return INVALID_MAP_HANDLE;
+
+  SECURITY_ATTRIBUTES security = {};
+  auto onExit = Utils::MakeScopeGuard([&]() {
+    ::LocalFree(security.lpSecurityDescriptor);
+  });
+
+  if (mapGlobally && !InitGlobalSecurityAttributes(security))
+    return INVALID_MAP_HANDLE;
+
+  auto const hMap = ::CreateFileMappingA(
+    INVALID_HANDLE_VALUE,
+    mapGlobally ? &security : nullptr,
+    PAGE_READWRITE | SEC_COMMIT | SEC_LARGE_PAGES,
+    0  /*dwMaximumSizeLow*/,
+    static_cast<DWORD>(size),
+    mappingName);
+
+  if (hMap == INVALID_MAP_HANDLE)
+    return INVALID_MAP_HANDLE;
+
+  // Existing section keeps its attributes (and might be smaller), let caller open it the regular way.
+  if (::GetLastError() == ERROR_ALREADY_EXISTS) {
+    ::CloseHandle(hMap);
+    ::SetLastError(ERROR_ALREADY_EXISTS);
+
+    return INVALID_MAP_HANDLE;
+  }
+
+  return hMap;
+#else
+  (void)mapGlobally;
+
+  char path[MAX_MAPPING_NAME_LEN] = {};
+  if (!BuildLargePagePath(mappingName, path)) {
+    errno = ENAMETOOLONG;
+    return INVALID_MAP_HANDLE;
+  }
+
+  auto fd = ::open(path, O_RDWR | O_CREAT | O_EXCL, 0666);
+  if (fd == INVALID_MAP_HANDLE && errno == EEXIST) {
+    alreadyExists = true;
+    fd = ::open(path, O_RDWR, 0666);
+  }
+
+  if (fd == INVALID_MAP_HANDLE)
+    return INVALID_MAP_HANDLE;
+
+  // Umask might have cut the permissions, and readers run under different accounts.
+  ::fchmod(fd, 0666);
+
+  struct stat st = {};
+  if (::fstat(fd, &st) != 0
+    || (static_cast<size_t>(st.st_size) < size && ::ftruncate(fd, static_cast<off_t>(size)) != 0)) {
+    auto const err = errno;
+    ::close(fd);
+    errno = err;
+
+    return INVALID_MAP_HANDLE;
+  }
+
+  // Same as in CreateMapping, but the other way around.
+  ::shm_unlink(mappingName);
+
+  return fd;
+#endif
+}
+
+// Creates the mapping, or opens the existing one.  Returns INVALID_MAP_HANDLE on failure, with the OS error code preserved.
+inline MapHandle CreateMapping(char const* const mappingName, size_t size, bool mapGlobally, bool& alreadyExists)
+{
+  alreadyExists = false;
+
+#ifdef _WIN32
+  MapHandle hMap = INVALID_MAP_HANDLE;
+  if (!mapGlobally) {
+    // Init handle and try to create, read if existing.
+    hMap = ::CreateFileMappingA(
+      INVALID_HANDLE_VALUE,
+      nullptr  /*lpFileMappingAttributes*/,
+      PAGE_READWRITE,
+      0  /*dwMaximumSizeLow*/,
+      static_cast<DWORD>(size),
+      mappingName);
+  }
+  else {
+    SECURITY_ATTRIBUTES security = {};
+    auto onExit = Utils::MakeScopeGuard([&]() {
+      ::LocalFree(security.lpSecurityDescriptor);
+    });
+
+    if (!InitGlobalSecurityAttributes(security))
+      return INVALID_MAP_HANDLE;
+
+    // Init handle and try to create, read if existing
+    hMap = ::CreateFileMappingA(
+      INVALID_HANDLE_VALUE,
+      &security,
+      PAGE_READWRITE,
+      0  /*dwMaximumSizeLow*/,
+      static_cast<DWORD>(size),
+      mappingName);
+  }
+
+  if (hMap != INVALID_MAP_HANDLE)
+    alreadyExists = ::GetLastError() == ERROR_ALREADY_EXISTS;
+
+  return hMap;
+#else
+  (void)mapGlobally;
+
+  auto fd = ::shm_open(mappingName, O_RDWR | O_CREAT | O_EXCL, 0666);
+  if (fd == INVALID_MAP_HANDLE && errno == EEXIST) {
+    alreadyExists = true;
+    fd = ::shm_open(mappingName, O_RDWR, 0666);
+  }
+
+  if (fd == INVALID_MAP_HANDLE)
+    return INVALID_MAP_HANDLE;
+
+  // Readers look for the large page mapping first, make sure they don't find the one left by the previous run.
+  char largePagePath[MAX_MAPPING_NAME_LEN] = {};
+  if (BuildLargePagePath(mappingName, largePagePath))
+    ::unlink(largePagePath);
+
+  // Existing object might be smaller (older layout), make sure it is large enough.  Never shrink it under the other processes.
+  struct stat st = {};
+  if (::fstat(fd, &st) != 0
+    || (static_cast<size_t>(st.st_size) < size && ::ftruncate(fd, static_cast<off_t>(size)) != 0)) {
+    auto const err = errno;
+    ::close(fd);
+    errno = err;
+
+    return INVALID_MAP_HANDLE;
+  }
+
+  return fd;
+#endif
+}
+
+// Maps view of the whole mapping.  Returns nullptr on failure.
+inline void* MapView(MapHandle hMap, size_t size)
+{
+#ifdef _WIN32
+  return ::MapViewOfFile(
+    hMap,
+    FILE_MAP_ALL_ACCESS,
+    0 /*dwFileOffsetHigh*/,
+    0 /*dwFileOffsetLow*/,
+    size);
+#else
+  auto const pView = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, hMap, 0 /*offset*/);
+  return pView != MAP_FAILED ? pView : nullptr;
+#endif
+}
+
+inline bool UnmapView(void const* pView, size_t size)
+{
+#ifdef _WIN32
+  (void)size;
+  return ::UnmapViewOfFile(pView) != FALSE;
+#else
+  return ::munmap(const_cast<void*>(pView), size) == 0;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////
+// Client side mapping access (see MappedBufferReader.h).
+
+// Builds the mapping name clients open.  dedicatedServerPid is 0 for the regular (game client) use.
+inline void BuildClientMappingName(char const* const fileName, unsigned long dedicatedServerPid, bool dedicatedServerMapGlobally, char (&mappingName)[MAX_MAPPING_NAME_LEN])
+{
+#ifdef _WIN32
+  if (dedicatedServerPid == 0uL)
+    strcpy_s(mappingName, fileName);
+  else if (dedicatedServerMapGlobally)
+    sprintf_s(mappingName, "Global\\%s%lu", fileName, dedicatedServerPid);
+  else
+    sprintf_s(mappingName, "%s%lu", fileName, dedicatedServerPid);
+#else
+  (void)dedicatedServerPid;
+  (void)dedicatedServerMapGlobally;
+  snprintf(mappingName, sizeof(mappingName), "/%s", fileName);
+#endif
+}
+
+// Opens existing mapping for reading.  Returns INVALID_MAP_HANDLE if the Plugin did not create it (yet).
+inline MapHandle OpenMappingReadOnly(char const* const mappingName)
+{
+#ifdef _WIN32
+  auto const hMap = ::OpenFileMappingA(FILE_MAP_READ, FALSE /*bInheritHandle*/, mappingName);
+  return hMap != nullptr ? hMap : INVALID_MAP_HANDLE;
+#else
+  // Large page mapping lives on the hugetlbfs mount, if Plugin managed to create it.
+  char largePagePath[MAX_MAPPING_NAME_LEN] = {};
+  if (BuildLargePagePath(mappingName, largePagePath)) {
+    auto const fd = ::open(largePagePath, O_RDONLY);
+    if (fd != INVALID_MAP_HANDLE)
+      return fd;
+  }
+
+  return ::shm_open(mappingName, O_RDONLY, 0);
+#endif
+}
+
+// Maps read only view of the whole mapping, and reports its size.  Returns nullptr on failure.
+inline void const* MapViewReadOnly(MapHandle hMap, size_t& size)
+{
+  size = 0u;
+
+#ifdef _WIN32
+  auto const pView = ::MapViewOfFile(hMap, FILE_MAP_READ, 0 /*dwFileOffsetHigh*/, 0 /*dwFileOffsetLow*/, 0 /*dwNumberOfBytesToMap*/);
+  if (pView == nullptr)
+    return nullptr;
+
+  // Mapping size is not available via handle, but the view covers the whole mapping (rounded up to the page size).
+  MEMORY_BASIC_INFORMATION mbi = {};
+  if (::VirtualQuery(pView, &mbi, sizeof(mbi)) == 0u) {
+    ::UnmapViewOfFile(pView);
+    return nullptr;
+  }
+
+  size = mbi.RegionSize;
+  return pView;
+#else
+  struct stat st = {};
+  if (::fstat(hMap, &st) != 0 || st.st_size <= 0)
+    return nullptr;
+
+  auto const pView = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, hMap, 0 /*offset*/);
+  if (pView == MAP_FAILED)
+    return nullptr;
+
+  size = static_cast<size_t>(st.st_size);
+  return pView;
+#endif
+}
+
+inline bool CloseMapping(MapHandle hMap)
+{
+#ifdef _WIN32
+  return ::CloseHandle(hMap) != FALSE;
+#else
+  return ::close(hMap) == 0;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////
+// Update notification.
+
+#ifdef _WIN32
+inline void BuildUpdateEventName(char const* const mappingName, int eventIndex, char (&eventName)[MAX_MAPPING_NAME_LEN])
+{
+  sprintf(eventName, "%s_Update%d", mappingName, eventIndex);
+}
+#endif
+
+// Writer side.  Creates (or opens existing) notification objects for the mapping.
+inline bool CreateUpdateNotifier(char const* const mappingName, bool mapGlobally, UpdateNotifier& notifier)
+{
+#ifdef _WIN32
+  SECURITY_ATTRIBUTES security = {};
+  auto onExit = Utils::MakeScopeGuard([&]() {
+    ::LocalFree(security.lpSecurityDescriptor);
+  });
+
+  if (mapGlobally && !InitGlobalSecurityAttributes(security))
+    return false;
+
+  for (int i = 0; i < 2; ++i) {
+    char eventName[MAX_MAPPING_NAME_LEN] = {};
+    BuildUpdateEventName(mappingName, i, eventName);
+
+    notifier.mhEvents[i] = ::CreateEventA(mapGlobally ? &security : nullptr, TRUE /*bManualReset*/, FALSE /*bInitialState*/, eventName);
+    if (notifier.mhEvents[i] == nullptr)
+      return false;
+  }
+#else
+  (void)mappingName;
+  (void)mapGlobally;
+#endif
+
+  notifier.mActive = true;
+  return true;
+}
+
+// Reader side.  Opens notification objects created by the Plugin.
+inline bool OpenUpdateNotifier(char const* const mappingName, UpdateNotifier& notifier)
+{
+#ifdef _WIN32
+  for (int i = 0; i < 2; ++i) {
+    char eventName[MAX_MAPPING_NAME_LEN] = {};
+    BuildUpdateEventName(mappingName, i, eventName);
+
+    notifier.mhEvents[i] = ::OpenEventA(SYNCHRONIZE, FALSE /*bInheritHandle*/, eventName);
+    if (notifier.mhEvents[i] == nullptr)
+      return false;
+  }
+#else
+  (void)mappingName;
+#endif
+
+  notifier.mActive = true;
+  return true;
+}
+
+inline void ReleaseUpdateNotifier(UpdateNotifier& notifier)
+{
+#ifdef _WIN32
+  for (int i = 0; i < 2; ++i) {
+    if (notifier.mhEvents[i] != nullptr)
+      ::CloseHandle(notifier.mhEvents[i]);
+
+    notifier.mhEvents[i] = nullptr;
+  }
+#endif
+
+  notifier.mActive = false;
+}
+
+// Writer side.  Has to be called after mVersionUpdateEnd is incremented.
+inline void NotifyUpdate(UpdateNotifier const& notifier, unsigned long volatile* pVersionUpdateEnd)
+{
+  if (!notifier.mActive)
+    return;
+
+#ifdef _WIN32
+  auto const version = *pVersionUpdateEnd;
+  ::ResetEvent(notifier.mhEvents[(version + 1uL) % 2uL]);
+  ::SetEvent(notifier.mhEvents[version % 2uL]);
+#elif defined(__linux__)
+  // Mapping is shared, so FUTEX_PRIVATE_FLAG must not be used.
+  ::syscall(SYS_futex, reinterpret_cast<unsigned long*>(const_cast<unsigned long*>(pVersionUpdateEnd)), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#else
+  (void)pVersionUpdateEnd;
+#endif
+}
+
+// Reader side.  Blocks until mVersionUpdateEnd moves past lastSeenVersion or timeout expires.  Returns true if version changed.
+inline bool WaitForUpdate(UpdateNotifier const& notifier, unsigned long const volatile* pVersionUpdateEnd, unsigned long lastSeenVersion, unsigned long timeoutMillis)
+{
+  if (*pVersionUpdateEnd != lastSeenVersion)
+    return true;
+
+  if (!notifier.mActive)
+    return false;
+
+#ifdef _WIN32
+  ::WaitForSingleObject(notifier.mhEvents[(lastSeenVersion + 1uL) % 2uL], timeoutMillis);
+#elif defined(__linux__)
+  static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Futex is done on the low 32 bits of the version variable.");
+
+  timespec timeout = {};
+  timeout.tv_sec = static_cast<time_t>(timeoutMillis / 1000uL);
+  timeout.tv_nsec = static_cast<long>(timeoutMillis % 1000uL) * 1000000L;
+  ::syscall(SYS_futex, const_cast<unsigned long*>(pVersionUpdateEnd), FUTEX_WAIT,
+    static_cast<unsigned int>(lastSeenVersion), &timeout, nullptr, 0);
+#else
+  (void)timeoutMillis;
+#endif
+
+  return *pVersionUpdateEnd != lastSeenVersion;
+}
+
+}
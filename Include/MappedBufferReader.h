@@ -0,0 +1,413 @@
+/*
+Definition of MappedBufferReader<> class.
+
+Author: The Iron Wolf (vleonavicius@hotmail.com)
+Website: thecrewchief.org
+
+Description:
+  Header only client side reader of the Plugin output buffers, for native clients that do not want to pay for
+  marshalling done by rF2SMMonitor.MappedBuffer<>.  Only depends on rF2State.h and MappedBufferPlatform.h (on Windows,
+  include windows.h first).
+
+  MappedBufferReader<> maps buffer read only and provides:
+    * Zero copy access: Read(reader) calls reader(BuffT const&) directly on the mapped frame, and validates afterwards
+      (seqlock style) that the Plugin did not touch the frame in the meantime.  If it did, read is retried, so reader
+      may be called more than once.  Only values reader copied out during the last call of a successful Read are
+      consistent, and reader must not keep references to the frame.
+    * Copy access: Copy(buff) copies the frame into buff.  If partial is requested, only the first mBytesUpdatedHint
+      bytes are copied for buffers that have it (rF2MappedBufferHeaderWithSize), the rest of buff keeps old values.
+      Note that mVehicleChangedBits and the vehicle indexes following them are not covered by mBytesUpdatedHint.
+    * Retry and backoff: failed attempt is retried right away for mNumSpinRetries times, then after yielding for
+      mNumYieldRetries times, then after sleeping for mSleepMillis up to mMaxRetries.
+    * Read statistics, same as rF2SMMonitor.MappedBuffer<>.GetStats().
+
+  Reader has to be told the layout Plugin mapped buffer in, which is reported by rF2Extended (Extended buffer itself
+  always uses the regular layout).  For triple buffered layout, published slot is read, so there's no need to wait
+  for the update in progress to complete.
+
+  Usage:
+    MappedBufferReader<rF2Extended> extended("$rFactor2SMMP_Extended$");
+    MappedBufferReader<rF2Telemetry> telemetry("$rFactor2SMMP_Telemetry$", true, true);  // Partial copies, skip unchanged.
+
+    rF2Extended ext;
+    if (extended.Connect() && extended.Copy(ext) == MappedBufferReadResult::Success)
+      telemetry.Connect(MappedBufferReaderLayout::FromExtended(ext, 1L));  // SubscribedBuffer::Telemetry
+
+    double playerSpeedSq = 0.0;
+    auto const result = telemetry.Read([&](rF2Telemetry const& telem) {
+      if (telem.mNumVehicles > 0)
+        playerSpeedSq = telem.mVehicles[0].mLocalVel.x * telem.mVehicles[0].mLocalVel.x + telem.mVehicles[0].mLocalVel.z * telem.mVehicles[0].mLocalVel.z;
+    });
+*/
+#pragma once
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <type_traits>
+
+#include "Utils.h"
+#include "rF2State.h"
+#include "MappedBufferPlatform.h"
+
+enum class MappedBufferReadResult
+{
+  Success,       // Frame read.
+  Unchanged,     // Frame did not change since the last successful read (only if skipUnchanged is requested).
+  Stuck,         // Frame version is the same as on the last failed read, not retried.
+  Failed,        // Ran out of retries.
+  NotConnected
+};
+
+
+// Layout Plugin mapped the buffer in.
+struct MappedBufferReaderLayout
+{
+  bool mTripleBuffered = false;      // See rF2Extended::mTripleBufferedBuffersMask.
+  bool mCacheLineIsolated = false;   // See rF2Extended::mCacheLineIsolatedBuffersMask.
+  bool mUpdateNotified = false;      // See rF2Extended::mUpdateNotificationBuffersMask.
+
+  // bufferFlag is the SubscribedBuffer value of the buffer (see README.md).
+  static MappedBufferReaderLayout FromExtended(rF2Extended const& extended, long bufferFlag)
+  {
+    MappedBufferReaderLayout layout;
+    layout.mTripleBuffered = (extended.mTripleBufferedBuffersMask & bufferFlag) != 0L;
+    layout.mCacheLineIsolated = (extended.mCacheLineIsolatedBuffersMask & bufferFlag) != 0L;
+    layout.mUpdateNotified = (extended.mUpdateNotificationBuffersMask & bufferFlag) != 0L;
+
+    return layout;
+  }
+};
+
+
+struct MappedBufferRetryPolicy
+{
+  int mMaxRetries = 10;              // Same as rF2SMMonitor.MappedBuffer<>.
+  int mNumSpinRetries = 2;
+  int mNumYieldRetries = 4;
+  unsigned long mSleepMillis = 1uL;
+};
+
+
+// Names match rF2SMMonitor.MappedBuffer<> statistics.
+struct MappedBufferReadStats
+{
+  int mNumReadRetriesPreCheck = 0;   // R1: update was in progress before the read.
+  int mNumReadRetries = 0;           // R2: update started during the read.
+  int mNumReadRetriesOnCheck = 0;    // R3: frame was replaced during the read.
+  int mNumReadFailures = 0;          // F: ran out of retries.
+  int mNumStuckFrames = 0;           // ST: skipped, because frame version matched the last failed read.
+  int mMaxRetries = 0;               // MR
+  int mNumSkippedNoChange = 0;       // SK
+  int mNumReadsSucceeded = 0;        // S
+
+  // Same format as rF2SMMonitor.MappedBuffer<>.GetStats().
+  template <size_t N>
+  void Format(char (&stats)[N]) const
+  {
+#ifdef _WIN32
+    sprintf_s(stats,
+#else
+    snprintf(stats, N,
+#endif
+      "R1: %d    R2: %d    R3: %d    F: %d    ST: %d    MR: %d    SK:%d    S:%d", mNumReadRetriesPreCheck, mNumReadRetries,
+      mNumReadRetriesOnCheck, mNumReadFailures, mNumStuckFrames, mMaxRetries, mNumSkippedNoChange, mNumReadsSucceeded);
+  }
+};
+
+
+template <typename BuffT>
+class MappedBufferReader
+{
+public:
+  MappedBufferReader(char const* mmFileName, bool partial = false, bool skipUnchanged = false)
+    : MM_FILE_NAME(mmFileName)
+    , mPartial(partial)
+    , mSkipUnchanged(skipUnchanged)
+  {}
+
+  ~MappedBufferReader()
+  {
+    Disconnect();
+  }
+
+  // Fails if the Plugin did not map the buffer (yet), or mapping is smaller than the requested layout needs.
+  // dedicatedServerPid is only needed to read from the dedicated server instance.
+  bool Connect(MappedBufferReaderLayout const& layout = MappedBufferReaderLayout(), unsigned long dedicatedServerPid = 0uL, bool dedicatedServerMapGlobally = false)
+  {
+    Disconnect();
+
+    char mappingName[MappedBufferPlatform::MAX_MAPPING_NAME_LEN] = {};
+    MappedBufferPlatform::BuildClientMappingName(MM_FILE_NAME, dedicatedServerPid, dedicatedServerMapGlobally, mappingName);
+
+    mhMap = MappedBufferPlatform::OpenMappingReadOnly(mappingName);
+    if (mhMap == MappedBufferPlatform::INVALID_MAP_HANDLE)
+      return false;
+
+    mpMappedView = MappedBufferPlatform::MapViewReadOnly(mhMap, mMappedSize);
+    if (mpMappedView == nullptr) {
+      Disconnect();
+      return false;
+    }
+
+    // Same layout math as MappedBuffer<>::Initialize.
+    auto const numSlots = layout.mTripleBuffered ? rF2MappedBufferSlotBlock::NUM_SLOTS : 1;
+    size_t headerSize = 0u;
+    if (layout.mCacheLineIsolated) {
+      size_t const lineSize = rF2MappedBufferLayout::CACHE_LINE_SIZE;
+      headerSize = rF2MappedBufferLayout::HEADER_SIZE;
+      mSlotStride = layout.mTripleBuffered ? (sizeof(BuffT) + lineSize - 1u) / lineSize * lineSize : sizeof(BuffT);
+    }
+    else {
+      headerSize = sizeof(rF2MappedBufferVersionBlock) + (layout.mTripleBuffered ? sizeof(rF2MappedBufferSlotBlock) : 0);
+      mSlotStride = sizeof(BuffT);
+    }
+
+    if (mMappedSize < headerSize + numSlots * mSlotStride) {
+      Disconnect();
+      return false;
+    }
+
+    auto const pView = static_cast<char const*>(mpMappedView);
+    mpVersionBlock = reinterpret_cast<rF2MappedBufferVersionBlock const*>(pView);
+    mpSlotBlock = layout.mTripleBuffered ? reinterpret_cast<rF2MappedBufferSlotBlock const*>(pView + sizeof(rF2MappedBufferVersionBlock)) : nullptr;
+    mpSlots = pView + headerSize;
+
+    // Failure to open notification objects is not fatal, WaitForUpdate polls then.
+    if (layout.mUpdateNotified
+      && !MappedBufferPlatform::OpenUpdateNotifier(mappingName, mNotifier))
+      MappedBufferPlatform::ReleaseUpdateNotifier(mNotifier);
+
+    return true;
+  }
+
+  void Disconnect()
+  {
+    MappedBufferPlatform::ReleaseUpdateNotifier(mNotifier);
+
+    if (mpMappedView != nullptr)
+      MappedBufferPlatform::UnmapView(mpMappedView, mMappedSize);
+
+    if (mhMap != MappedBufferPlatform::INVALID_MAP_HANDLE)
+      MappedBufferPlatform::CloseMapping(mhMap);
+
+    mhMap = MappedBufferPlatform::INVALID_MAP_HANDLE;
+    mpMappedView = nullptr;
+    mMappedSize = 0u;
+    mpVersionBlock = nullptr;
+    mpSlotBlock = nullptr;
+    mpSlots = nullptr;
+    mSlotStride = sizeof(BuffT);
+
+    mHasLastReadVersion = false;
+    mLastReadVersion = 0uL;
+    mStuck = false;
+
+    ClearStats();
+  }
+
+  bool IsConnected() const { return mpMappedView != nullptr; }
+
+  // Zero copy read.  See the file header for the reader requirements.
+  template <typename ReaderT>
+  MappedBufferReadResult Read(ReaderT&& reader)
+  {
+    if (!IsConnected())
+      return MappedBufferReadResult::NotConnected;
+
+    auto frameVersion = 0uL;
+    auto versionEnd = 0uL;
+    auto retry = 0;
+    for (retry = 0; retry < mRetryPolicy.mMaxRetries; ++retry) {
+      if (retry > 0)
+        Backoff(retry);
+
+      // Pre-check.  In the triple buffered layout, frame version is the published slot stamp, otherwise it is
+      // the version block, which has to be in sync.
+      auto slot = 0uL;
+      if (mpSlotBlock != nullptr) {
+        slot = MappedBufferPlatform::AtomicLoad(&mpSlotBlock->mPublishedSlot);
+        frameVersion = versionEnd = slot < static_cast<unsigned long>(rF2MappedBufferSlotBlock::NUM_SLOTS)
+          ? MappedBufferPlatform::AtomicLoad(&mpSlotBlock->mSlotVersions[slot]) : 0uL;
+      }
+      else {
+        frameVersion = MappedBufferPlatform::AtomicLoad(&mpVersionBlock->mVersionUpdateBegin);
+        versionEnd = MappedBufferPlatform::AtomicLoad(&mpVersionBlock->mVersionUpdateEnd);
+      }
+
+      // If this is stale "out of sync" situation we're stuck in, there's no point in retrying.
+      if (mStuck && frameVersion == mStuckVersionBegin && versionEnd == mStuckVersionEnd) {
+        ++mStats.mNumStuckFrames;
+        return MappedBufferReadResult::Stuck;
+      }
+
+      if (mSkipUnchanged && mHasLastReadVersion
+        && frameVersion == mLastReadVersion && versionEnd == mLastReadVersion) {
+        ++mStats.mNumSkippedNoChange;
+        return MappedBufferReadResult::Unchanged;
+      }
+
+      if (frameVersion != versionEnd || (mpSlotBlock != nullptr && frameVersion == 0uL)) {
+        ++mStats.mNumReadRetriesPreCheck;
+        continue;
+      }
+
+      reader(*GetSlot(slot));
+
+      // Post-check.  Frame reads above must not be reordered past the version reads below.
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      auto postVersionBegin = 0uL;
+      auto postVersionEnd = 0uL;
+      if (mpSlotBlock != nullptr)
+        postVersionBegin = postVersionEnd = MappedBufferPlatform::AtomicLoad(&mpSlotBlock->mSlotVersions[slot]);
+      else {
+        postVersionBegin = MappedBufferPlatform::AtomicLoad(&mpVersionBlock->mVersionUpdateBegin);
+        postVersionEnd = MappedBufferPlatform::AtomicLoad(&mpVersionBlock->mVersionUpdateEnd);
+      }
+
+      if (postVersionBegin != postVersionEnd || (mpSlotBlock != nullptr && postVersionBegin == 0uL)) {
+        ++mStats.mNumReadRetries;
+        continue;
+      }
+
+      if (postVersionBegin != frameVersion) {
+        ++mStats.mNumReadRetriesOnCheck;
+        continue;
+      }
+
+      // Success.
+      mStats.mMaxRetries = retry > mStats.mMaxRetries ? retry : mStats.mMaxRetries;
+      ++mStats.mNumReadsSucceeded;
+      mStuck = false;
+
+      mHasLastReadVersion = true;
+      mLastReadVersion = frameVersion;
+
+      return MappedBufferReadResult::Success;
+    }
+
+    // Failure.  Save the frame version if it was out of sync (or never published), so that we do not keep retrying on it.
+    // Unlike rF2SMMonitor.MappedBuffer<>, failure caused by frequent updates does not count as stuck.
+    mStuck = frameVersion != versionEnd || (mpSlotBlock != nullptr && frameVersion == 0uL);
+    mStuckVersionBegin = frameVersion;
+    mStuckVersionEnd = versionEnd;
+
+    mStats.mMaxRetries = retry > mStats.mMaxRetries ? retry : mStats.mMaxRetries;
+    ++mStats.mNumReadFailures;
+
+    return MappedBufferReadResult::Failed;
+  }
+
+  // Copy read.  Copies only the updated part of the frame if partial is requested.
+  MappedBufferReadResult Copy(BuffT& buff)
+  {
+    return Read([&](BuffT const& frame) {
+      auto const bytesToCopy = mPartial
+        ? GetBytesUpdated(frame, std::is_base_of<rF2MappedBufferHeaderWithSize, BuffT>())
+        : sizeof(BuffT);
+
+      memcpy(&buff, &frame, bytesToCopy);
+    });
+  }
+
+  // Same as rF2SMMonitor.MappedBuffer<>.GetMappedDataUnsynchronized, but without copying.
+  BuffT const* GetUnsynchronized() const
+  {
+    if (!IsConnected())
+      return nullptr;
+
+    return mpSlotBlock != nullptr ? GetSlot(mpSlotBlock->mPublishedSlot % rF2MappedBufferSlotBlock::NUM_SLOTS) : GetSlot(0uL);
+  }
+
+  // Blocks until the frame newer than the last successfully read one is published, or timeout expires.  Returns true
+  // if there's a new frame.  If update notification is not available, polls every mSleepMillis instead.
+  bool WaitForUpdate(unsigned long timeoutMillis)
+  {
+    if (!IsConnected())
+      return false;
+
+    if (mNotifier.mActive)
+      return MappedBufferPlatform::WaitForUpdate(mNotifier, &mpVersionBlock->mVersionUpdateEnd, mLastReadVersion, timeoutMillis);
+
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMillis);
+    while (MappedBufferPlatform::AtomicLoad(&mpVersionBlock->mVersionUpdateEnd) == mLastReadVersion) {
+      if (std::chrono::steady_clock::now() >= deadline)
+        return false;
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(mRetryPolicy.mSleepMillis));
+    }
+
+    return true;
+  }
+
+  bool IsUpdateNotified() const { return mNotifier.mActive; }
+  unsigned long GetLastReadVersion() const { return mLastReadVersion; }
+
+  MappedBufferReadStats const& GetStats() const { return mStats; }
+  void ClearStats() { mStats = MappedBufferReadStats(); }
+
+  MappedBufferRetryPolicy mRetryPolicy;
+
+private:
+  MappedBufferReader(MappedBufferReader const&) = delete;
+  MappedBufferReader& operator=(MappedBufferReader const&) = delete;
+
+  BuffT const* GetSlot(unsigned long slot) const
+  {
+    return reinterpret_cast<BuffT const*>(mpSlots + slot * mSlotStride);
+  }
+
+  void Backoff(int retry) const
+  {
+    if (retry <= mRetryPolicy.mNumSpinRetries)
+      return;
+    else if (retry <= mRetryPolicy.mNumSpinRetries + mRetryPolicy.mNumYieldRetries)
+      std::this_thread::yield();
+    else
+      std::this_thread::sleep_for(std::chrono::milliseconds(mRetryPolicy.mSleepMillis));
+  }
+
+  // mBytesUpdatedHint is read while frame might be getting overwritten, so it is clamped.  Read is validated anyway.
+  static size_t GetBytesUpdated(BuffT const& frame, std::true_type)
+  {
+    auto const hint = *static_cast<int const volatile*>(&frame.mBytesUpdatedHint);
+    if (hint <= static_cast<int>(sizeof(rF2MappedBufferHeaderWithSize)) || hint > static_cast<int>(sizeof(BuffT)))
+      return sizeof(BuffT);
+
+    return static_cast<size_t>(hint);
+  }
+
+  static size_t GetBytesUpdated(BuffT const&, std::false_type)
+  {
+    return sizeof(BuffT);
+  }
+
+  char const* const MM_FILE_NAME = nullptr;
+  bool const mPartial = false;
+  bool const mSkipUnchanged = false;
+
+  MappedBufferPlatform::MapHandle mhMap = MappedBufferPlatform::INVALID_MAP_HANDLE;
+  void const* mpMappedView = nullptr;
+  size_t mMappedSize = 0u;
+
+  rF2MappedBufferVersionBlock const* mpVersionBlock = nullptr;
+  rF2MappedBufferSlotBlock const* mpSlotBlock = nullptr;  // nullptr for the regular single buffer layout.
+  char const* mpSlots = nullptr;
+  size_t mSlotStride = sizeof(BuffT);
+
+  MappedBufferPlatform::UpdateNotifier mNotifier;
+
+  bool mHasLastReadVersion = false;
+  unsigned long mLastReadVersion = 0uL;
+
+  bool mStuck = false;
+  unsigned long mStuckVersionBegin = 0uL;
+  unsigned long mStuckVersionEnd = 0uL;
+
+  MappedBufferReadStats mStats;
+};
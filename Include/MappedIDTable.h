@@ -0,0 +1,145 @@
+/*
+Definition of MappedIDTable class.
+
+Author: The Iron Wolf (vleonavicius@hotmail.com)
+Website: thecrewchief.org
+
+Description:
+  MappedIDTable maps vehicle mID to a slot in [0, rF2Extended::MAX_MAPPED_IDS) range, used to index per vehicle
+  plugin state (telemetry frame assembly, damage tracking).  Table is open addressed with linear probing, and home
+  slot of an mID is mID % rF2Extended::MAX_MAPPED_IDS, so as long as mIDs do not collide, slot is the same as the
+  old modulo index.  Colliding mID is moved to the next free slot instead of aliasing.
+
+  Table is stamped with the generation, which is advanced on each telemetry frame (NextGeneration).  Stamp marks
+  the slot as updated in the current generation, so there's no need to clear anything between frames.  Slots not
+  stamped for STALE_GENERATIONS are reused for the new mIDs, so long running dedicated servers, where mIDs keep
+  growing as people come and go, do not run out of slots.  Caller is told when slot got (re)assigned, so that
+  state kept for the previous owner can be reset.
+
+  Table is cleared on session (re)start, see Clear.
+*/
+#pragma once
+
+#include <assert.h>
+#include <string.h>
+
+#include "rF2State.h"
+
+class MappedIDTable
+{
+public:
+  static int const NUM_SLOTS = rF2Extended::MAX_MAPPED_IDS;
+  static long const EMPTY_ID = -1L;
+
+  // Slot not stamped for this many generations (telemetry frames, so about a minute) can be taken over by the new mID.
+  static unsigned long const STALE_GENERATIONS = 50uL * 60uL;
+
+  MappedIDTable()
+  {
+    Clear();
+  }
+
+  void Clear()
+  {
+    for (int i = 0; i < MappedIDTable::NUM_SLOTS; ++i)
+      mIDs[i] = MappedIDTable::EMPTY_ID;
+
+    memset(mStamps, 0, sizeof(mStamps));
+
+    // Start past 0, so that no slot appears stamped in the current generation.
+    mGeneration = 1uL;
+  }
+
+  void NextGeneration()
+  {
+    ++mGeneration;
+  }
+
+  // Returns slot of the mID, or -1 if mID is not mapped.
+  long Find(long id) const
+  {
+    id = MappedIDTable::SanitizeID(id);
+
+    auto slot = MappedIDTable::HomeSlot(id);
+    for (int probe = 0; probe < MappedIDTable::NUM_SLOTS; ++probe) {
+      if (mIDs[slot] == id)
+        return slot;
+
+      if (mIDs[slot] == MappedIDTable::EMPTY_ID)
+        return -1L;
+
+      slot = (slot + 1L) % MappedIDTable::NUM_SLOTS;
+    }
+
+    return -1L;
+  }
+
+  // Returns slot of the mID, mapping it if necessary.  slotAssigned is set if slot was (re)assigned to the mID
+  // by this call.  Returns -1 if table is full of live mIDs.
+  long FindOrAdd(long id, bool& slotAssigned)
+  {
+    slotAssigned = false;
+    id = MappedIDTable::SanitizeID(id);
+
+    auto slot = MappedIDTable::HomeSlot(id);
+    auto firstStaleSlot = -1L;
+    for (int probe = 0; probe < MappedIDTable::NUM_SLOTS; ++probe) {
+      if (mIDs[slot] == id)
+        return slot;
+
+      if (mIDs[slot] == MappedIDTable::EMPTY_ID) {
+        // Not mapped.  Prefer reusing stale slot earlier in the chain, it keeps chains short.
+        if (firstStaleSlot == -1L)
+          firstStaleSlot = slot;
+
+        break;
+      }
+
+      if (firstStaleSlot == -1L && IsStale(slot))
+        firstStaleSlot = slot;
+
+      slot = (slot + 1L) % MappedIDTable::NUM_SLOTS;
+    }
+
+    if (firstStaleSlot == -1L)
+      return -1L;
+
+    // Stale slot is replaced in place, so the chains going through it stay intact.
+    mIDs[firstStaleSlot] = id;
+
+    // Not updated in the current generation, but not stale either.
+    mStamps[firstStaleSlot] = mGeneration - 1uL;
+    slotAssigned = true;
+
+    return firstStaleSlot;
+  }
+
+  bool IsStamped(long slot) const
+  {
+    assert(slot >= 0L && slot < MappedIDTable::NUM_SLOTS);
+    return mStamps[slot] == mGeneration;
+  }
+
+  void Stamp(long slot)
+  {
+    assert(slot >= 0L && slot < MappedIDTable::NUM_SLOTS);
+    mStamps[slot] = mGeneration;
+  }
+
+  long GetID(long slot) const
+  {
+    assert(slot >= 0L && slot < MappedIDTable::NUM_SLOTS);
+    return mIDs[slot];
+  }
+
+private:
+  // Negative mID is not supported, treat it as 0 (same as the old modulo index did).
+  static long SanitizeID(long id) { return id > 0L ? id : 0L; }
+  static long HomeSlot(long id) { return id % MappedIDTable::NUM_SLOTS; }
+
+  bool IsStale(long slot) const { return mGeneration - mStamps[slot] > MappedIDTable::STALE_GENERATIONS; }
+
+  long mIDs[MappedIDTable::NUM_SLOTS];
+  unsigned long mStamps[MappedIDTable::NUM_SLOTS];
+  unsigned long mGeneration = 1uL;
+};
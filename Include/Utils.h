@@ -9,6 +9,9 @@ Website: thecrewchief.org
 
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
+
 namespace Utils
 {
 
@@ -65,7 +68,9 @@ uintptr_t FindPattern(uintptr_t start, size_t length, unsigned char const* patte
 /// <param name="mask">The mask (Example: "x?x")</param>
 /// <param name="bytedIntoPatternToFindOffset">nr bytes into found address to add to get the pointer offset (Example: -?+?)</param>
 /// <returns>The address of the found pattern or -1 if the pattern was not found.</returns>
+#ifdef _WIN32
 uintptr_t* FindPatternForPointerInMemory(HMODULE module, unsigned char const* pattern, char const* mask, size_t bytedIntoPatternToFindPointer);
+#endif
 
 char* GetFileContents(char const* const filePath);
 
@@ -22,6 +22,25 @@ Description:
 */
 #pragma once
 
+#ifndef _WIN32
+// Allows consuming the mapped layout on POSIX platforms (see MappedBufferPlatform.h).
+typedef unsigned long long ULONGLONG;
+typedef void* HWND;
+
+// Pointer placeholders below are sized based on _AMD64_.
+#if defined(__LP64__) && !defined(_AMD64_)
+#define _AMD64_
+#endif
+#endif
+
+// Layout checks against the game SDK types.  Those are only possible if InternalsPlugin.hpp is included (which is always the
+// case for the Plugin), so that clients can consume this header without the SDK.
+#ifdef _INTERNALS_PLUGIN_HPP_
+#define RF2_SDK_LAYOUT_CHECK(expr, msg) static_assert(expr, msg)
+#else
+#define RF2_SDK_LAYOUT_CHECK(expr, msg)
+#endif
+
 // Use 4 to match ISI pack.
 #pragma pack(push, 4)
 #pragma warning(disable : 4121)   // Alignment sensitivity (ISI sets 4 byte pack)
@@ -168,7 +187,7 @@ struct rF2Vec3
 {
   double x, y, z;
 };
-static_assert(sizeof(rF2Vec3) == sizeof(TelemVect3), "rF2Vec3 and TelemVect3 structures are out of sync");
+RF2_SDK_LAYOUT_CHECK(sizeof(rF2Vec3) == sizeof(TelemVect3), "rF2Vec3 and TelemVect3 structures are out of sync");
 
 
 /////////////////////////////////////
@@ -211,7 +230,7 @@ struct rF2Wheel
 
   unsigned char mExpansion[24];  // for future use
 };
-static_assert(sizeof(rF2Wheel) == sizeof(TelemWheelV01), "rF2Wheel and TelemWheelV01 structures are out of sync");
+RF2_SDK_LAYOUT_CHECK(sizeof(rF2Wheel) == sizeof(TelemWheelV01), "rF2Wheel and TelemWheelV01 structures are out of sync");
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Identical to TelemInfoV01, except where noted by MM_NEW/MM_NOT_USED comments.
@@ -324,7 +343,7 @@ struct rF2VehicleTelemetry
   // keeping this at the end of the structure to make it easier to replace in future versions
   rF2Wheel mWheels[4];                     // wheel info (front left, front right, rear left, rear right)
 };
-static_assert(sizeof(rF2VehicleTelemetry) == sizeof(TelemInfoV01), "rF2VehicleTelemetry and TelemInfoV01 structures are out of sync");
+RF2_SDK_LAYOUT_CHECK(sizeof(rF2VehicleTelemetry) == sizeof(TelemInfoV01), "rF2VehicleTelemetry and TelemInfoV01 structures are out of sync");
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Identical to ScoringInfoV01, except where noted by MM_NEW/MM_NOT_USED comments.
@@ -413,7 +432,7 @@ struct rF2ScoringInfo
   unsigned char pointer2[4];
 #endif
 };
-static_assert(sizeof(rF2ScoringInfo) == sizeof(ScoringInfoV01), "rF2ScoringInfo and ScoringInfoV01 structures are out of sync");
+RF2_SDK_LAYOUT_CHECK(sizeof(rF2ScoringInfo) == sizeof(ScoringInfoV01), "rF2ScoringInfo and ScoringInfoV01 structures are out of sync");
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -496,7 +515,7 @@ struct rF2VehicleScoring
   // tag.2012.04.06 - SEE ABOVE!
   unsigned char mExpansion[48];  // for future use
 };
-static_assert(sizeof(rF2VehicleScoring) == sizeof(VehicleScoringInfoV01), "rF2VehicleScoring and VehicleScoringInfoV01 structures are out of sync");
+RF2_SDK_LAYOUT_CHECK(sizeof(rF2VehicleScoring) == sizeof(VehicleScoringInfoV01), "rF2VehicleScoring and VehicleScoringInfoV01 structures are out of sync");
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -537,7 +556,7 @@ struct rF2PhysicsOptions
   float mSpeedSensitiveSteering;   // 0.0 (off) - 1.0
   float mSteerRatioSpeed;          // speed (m/s) under which lock gets expanded to full
 };
-static_assert(sizeof(rF2PhysicsOptions) == sizeof(PhysicsOptionsV01), "rF2PhysicsOptions and PhysicsOptionsV01 structures are out of sync");
+RF2_SDK_LAYOUT_CHECK(sizeof(rF2PhysicsOptions) == sizeof(PhysicsOptionsV01), "rF2PhysicsOptions and PhysicsOptionsV01 structures are out of sync");
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -570,7 +589,7 @@ struct rF2GraphicsInfo
 
   unsigned char mExpansion[128]; // for future use (possibly camera name)
 };
-static_assert(sizeof(rF2GraphicsInfo) == sizeof(GraphicsInfoV02), "rF2GraphicsInfo and GraphicsInfoV02 structures are out of sync");
+RF2_SDK_LAYOUT_CHECK(sizeof(rF2GraphicsInfo) == sizeof(GraphicsInfoV02), "rF2GraphicsInfo and GraphicsInfoV02 structures are out of sync");
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -590,7 +609,7 @@ enum class rF2TrackRulesCommand
   //------------------
   Maximum                       // should be last
 };
-static_assert(sizeof(rF2TrackRulesCommand) == sizeof(TrackRulesCommandV01), "rF2TrackRulesCommand and TrackRulesCommandV01 enums are out of sync");
+RF2_SDK_LAYOUT_CHECK(sizeof(rF2TrackRulesCommand) == sizeof(TrackRulesCommandV01), "rF2TrackRulesCommand and TrackRulesCommandV01 enums are out of sync");
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -603,7 +622,7 @@ struct rF2TrackRulesAction
   long mID;                             // slot ID if applicable
   double mET;                           // elapsed time that event occurred, if applicable
 };
-static_assert(sizeof(rF2TrackRulesAction) == sizeof(TrackRulesActionV01), "rF2TrackRulesAction and TrackRulesActionV01 structs are out of sync");
+RF2_SDK_LAYOUT_CHECK(sizeof(rF2TrackRulesAction) == sizeof(TrackRulesActionV01), "rF2TrackRulesAction and TrackRulesActionV01 structs are out of sync");
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -625,7 +644,7 @@ enum class rF2TrackRulesColumn
   //------------------
   Maximum                        // should be last
 };
-static_assert(sizeof(rF2TrackRulesColumn) == sizeof(TrackRulesColumnV01), "rF2TrackRulesColumn and TrackRulesColumnV01 enums are out of sync");
+RF2_SDK_LAYOUT_CHECK(sizeof(rF2TrackRulesColumn) == sizeof(TrackRulesColumnV01), "rF2TrackRulesColumn and TrackRulesColumnV01 enums are out of sync");
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -653,7 +672,7 @@ struct rF2TrackRulesParticipant
   // future expansion
   unsigned char mExpansion[ 192 ];
 };
-static_assert(sizeof(rF2TrackRulesParticipant) == sizeof(TrackRulesParticipantV01), "rF2TrackRulesParticipant and TrackRulesParticipantV01 structs are out of sync");
+RF2_SDK_LAYOUT_CHECK(sizeof(rF2TrackRulesParticipant) == sizeof(TrackRulesParticipantV01), "rF2TrackRulesParticipant and TrackRulesParticipantV01 structs are out of sync");
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -669,7 +688,7 @@ enum class rF2TrackRulesStage
   //------------------
   Maximum                      // should be last
 };
-static_assert(sizeof(rF2TrackRulesColumn) == sizeof(TrackRulesColumnV01), "rF2TrackRulesColumn and TrackRulesColumnV01 enums are out of sync");
+RF2_SDK_LAYOUT_CHECK(sizeof(rF2TrackRulesColumn) == sizeof(TrackRulesColumnV01), "rF2TrackRulesColumn and TrackRulesColumnV01 enums are out of sync");
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -739,7 +758,7 @@ struct rF2TrackRules
   // future input/output expansion
   unsigned char mInputOutputExpansion[ 256 ];
 };
-static_assert(sizeof(rF2TrackRules) == sizeof(TrackRulesV01), "rF2TrackRules and TrackRulesV01 structs are out of sync");
+RF2_SDK_LAYOUT_CHECK(sizeof(rF2TrackRules) == sizeof(TrackRulesV01), "rF2TrackRules and TrackRulesV01 structs are out of sync");
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -768,7 +787,7 @@ struct rF2MultiSessionParticipant
                                         // future expansion
   unsigned char mExpansion[128];
 };
-static_assert(sizeof(rF2MultiSessionParticipant) == sizeof(MultiSessionParticipantV01), "rF2MultiSessionParticipant and MultiSessionParticipantV01 structs are out of sync");
+RF2_SDK_LAYOUT_CHECK(sizeof(rF2MultiSessionParticipant) == sizeof(MultiSessionParticipantV01), "rF2MultiSessionParticipant and MultiSessionParticipantV01 structs are out of sync");
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -801,7 +820,7 @@ struct rF2MultiSessionRules
                                       // future expansion
   unsigned char mExpansion[256];
 };
-static_assert(sizeof(rF2MultiSessionRules) == sizeof(MultiSessionRulesV01), "rF2MultiSessionRules and MultiSessionRulesV01 structs are out of sync");
+RF2_SDK_LAYOUT_CHECK(sizeof(rF2MultiSessionRules) == sizeof(MultiSessionRulesV01), "rF2MultiSessionRules and MultiSessionRulesV01 structs are out of sync");
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -818,7 +837,7 @@ struct rF2PitMenu
 
   unsigned char mExpansion[256];        // for future use
 };
-static_assert(sizeof(rF2PitMenu) == sizeof(PitMenuV01), "rF2PitMenu and PitMenuV0 structs are out of sync");
+RF2_SDK_LAYOUT_CHECK(sizeof(rF2PitMenu) == sizeof(PitMenuV01), "rF2PitMenu and PitMenuV0 structs are out of sync");
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -848,7 +867,7 @@ struct rF2WeatherControlInfo
 
   unsigned char mExpansion[508];      // future use (humidity, pressure, air density, etc.)
 };
-static_assert(sizeof(rF2WeatherControlInfo) == sizeof(WeatherControlInfoV01), "rF2WeatherControlInfo and WeatherControlInfoV01 structs are out of sync");
+RF2_SDK_LAYOUT_CHECK(sizeof(rF2WeatherControlInfo) == sizeof(WeatherControlInfoV01), "rF2WeatherControlInfo and WeatherControlInfoV01 structs are out of sync");
 
 
 ///////////////////////////////////////////
@@ -862,6 +881,41 @@ struct rF2MappedBufferVersionBlock
 };
 
 
+// Only present in buffers mapped in the triple buffered layout (see rF2Extended::mTripleBufferedBuffersMask).
+// Such buffers are laid out as: rF2MappedBufferVersionBlock, rF2MappedBufferSlotBlock, followed by NUM_SLOTS copies of the buffer.
+// Writer never touches the published slot, so reader copies mPublishedSlot and verifies mSlotVersions[slot] did not change during the copy.
+struct rF2MappedBufferSlotBlock
+{
+  static int const NUM_SLOTS = 3;
+
+  unsigned long mPublishedSlot;                                   // Index of the slot holding the last completed frame.
+  unsigned long mSlotVersions[rF2MappedBufferSlotBlock::NUM_SLOTS];  // mVersionUpdateBegin of the frame held by each slot, 0 while slot is being written to.
+};
+
+
+// Buffers mapped in the cache line isolated layout (see rF2Extended::mCacheLineIsolatedBuffersMask) have the header
+// (rF2MappedBufferVersionBlock, plus rF2MappedBufferSlotBlock if triple buffered) padded to HEADER_SIZE bytes, and
+// each slot of the triple buffered layout padded to the multiple of CACHE_LINE_SIZE bytes.  That way, readers polling
+// the version block do not share the cache line with the writer updating the buffer contents.
+struct rF2MappedBufferLayout
+{
+  static int const CACHE_LINE_SIZE = 64;
+  static int const HEADER_SIZE = rF2MappedBufferLayout::CACHE_LINE_SIZE;
+};
+
+
+// Follows the last slot of every output buffer (mapped view is sizeof(rF2MappedBufferPublishStamp) bytes longer), so nothing
+// existing clients read moves.  Written by the plugin right before mVersionUpdateEnd is incremented, so reader that copies it
+// together with the buffer gets the stamp of the same update.  Triple buffered layout readers should check that mVersion matches
+// mSlotVersions of the slot they read.
+struct rF2MappedBufferPublishStamp
+{
+  unsigned long mVersion;                 // mVersionUpdateBegin of the update stamped.
+  ULONGLONG mTimestamp;                   // When update was published.  QueryPerformanceCounter value (rF2Statistics::mTimestampFrequency ticks per second).
+  double mElapsedTime;                    // Game ET of the published data, -1.0 if it does not apply to the buffer.
+};
+
+
 struct rF2MappedBufferHeader
 {
   static int const MAX_MAPPED_VEHICLES = 128;
@@ -875,11 +929,181 @@ struct rF2MappedBufferHeaderWithSize : public rF2MappedBufferHeader
 };
 
 
+// mID to mVehicles index map, published at the end of Telemetry and Scoring buffers, so it is consistent with the vehicles
+// of the same update.  Allows joining Telemetry and Scoring vehicles without scanning for the matching mID.
+// Lookup: start at slot (mID % NUM_SLOTS).  If mIDs[slot] holds another mID, continue to the next slot (wrapping around) until
+// mID is found, or empty slot (-1) is hit, which means mID is not in the update.  Cleared buffer (mNumVehicles == 0) has all
+// the slots empty.
+struct rF2VehicleIDIndex
+{
+  static int const NUM_SLOTS = 2 * rF2MappedBufferHeader::MAX_MAPPED_VEHICLES;  // Keeps probe chains short.
+
+  long mIDs[rF2VehicleIDIndex::NUM_SLOTS];                      // mID held in the slot, -1 if the slot is empty.
+  unsigned char mVehicleIndices[rF2VehicleIDIndex::NUM_SLOTS];  // mVehicles index of mIDs[slot].
+};
+
+
 struct rF2Telemetry : public rF2MappedBufferHeaderWithSize
 {
   long mNumVehicles;             // current number of vehicles
 
   rF2VehicleTelemetry mVehicles[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];
+
+  // MM_NEW
+  // Bit (i % 8) of byte (i / 8) is set if mVehicles[i] changed since the previous update (mID and everything except mDeltaTime
+  // and mElapsedTime is compared, because those tick for every vehicle).  Only valid if previous update was read, so readers that
+  // skipped an update (mVersionUpdateBegin moved by more than one) need to copy all the vehicles.
+  unsigned char mVehicleChangedBits[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES / 8];
+
+  // MM_NEW
+  // mID to mVehicles index map of this update.
+  rF2VehicleIDIndex mVehicleIDIndex;
+};
+
+
+struct rF2TelemetryHistoryFrame
+{
+  unsigned long mSequence;                  // Sequence number of the frame held in this slot.  0 while slot is empty or being written to.
+  double mElapsedTime;                      // Game ET of the frame.
+  long mNumVehicles;                        // Number of vehicles in the frame.
+  unsigned long mFirstVehicle;              // Running index of the frame's first vehicle in the vehicle pool.  Vehicle i of the frame is at
+                                            // mVehicles[(mFirstVehicle + i) % rF2TelemetryHistory::MAX_VEHICLE_SLOTS].
+};
+
+
+// Keeps last completed telemetry frames, so that clients can read at their own pace.
+// Frame with sequence number N is at mFrames[N % MAX_FRAMES].  Vehicles of the frame are intact as long as
+// mVehiclesWritten - mFirstVehicle <= MAX_VEHICLE_SLOTS after they were copied out.
+// Vehicle pool is shared by all frames, so MAX_FRAMES is only held with up to MAX_VEHICLE_SLOTS / MAX_FRAMES (32) vehicles in
+// the field: 256 frames is ~5s at 50FPS, while with 60 vehicles the pool holds 136 frames (~2.7s).  Frame headers of older frames
+// are still there, but their vehicles are overwritten.  mReadableFrames tells how many of the last frames are intact.
+struct rF2TelemetryHistory : public rF2MappedBufferHeader
+{
+  static int const MAX_FRAMES = 256;
+  static int const MAX_VEHICLE_SLOTS = 8192;
+
+  unsigned long mLastSequence;              // Sequence number of the last completed frame, starts at 1.  0 means no frames captured.
+  unsigned long mVehiclesWritten;           // Running count of vehicles written into the pool, including the frame currently being written.
+  unsigned long mReadableFrames;            // Number of the last frames (up to mLastSequence) whose vehicles are not overwritten.
+
+  rF2TelemetryHistoryFrame mFrames[rF2TelemetryHistory::MAX_FRAMES];
+  rF2VehicleTelemetry mVehicles[rF2TelemetryHistory::MAX_VEHICLE_SLOTS];
+};
+
+
+// Compact subset of rF2Telemetry needed by the most HUDs and dashes, filled from each completed Telemetry frame.
+// Struct-of-arrays layout: value of the field for vehicle i (same order as rF2Telemetry::mVehicles) is at mField[i].
+// Each array starts at the multiple of rF2MappedBufferLayout::CACHE_LINE_SIZE bytes from the structure start (so in memory
+// as well, if buffer is mapped in the cache line isolated layout), which allows reading them with aligned SIMD loads.
+// Values that do not need double precision are stored as floats.
+struct rF2TelemetryLite : public rF2MappedBufferHeader
+{
+  double mElapsedTime;                      // Game ET of the frame (min mElapsedTime of vehicles in the frame).
+  long mNumVehicles;                        // Number of valid entries in each array.
+  unsigned char mExpansion[rF2MappedBufferLayout::CACHE_LINE_SIZE - sizeof(double) - sizeof(long)];  // Pads the header to the cache line.
+
+  long mID[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];                  // slot ID
+  long mLapNumber[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];           // current lap number
+  long mCurrentSector[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];       // zero-based sector, with pitlane stored in the sign bit
+  double mLapStartET[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];        // time this lap was started
+
+  float mPosX[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];               // world position in meters
+  float mPosY[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];
+  float mPosZ[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];
+  float mSpeed[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];              // magnitude of mLocalVel (meters/sec)
+
+  float mEngineRPM[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];          // engine RPM
+  float mEngineMaxRPM[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];       // rev limit
+
+  float mFilteredThrottle[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];   // ranges  0.0-1.0
+  float mFilteredBrake[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];      // ranges  0.0-1.0
+  float mFilteredClutch[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];     // ranges  0.0-1.0
+  float mFilteredSteering[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];   // ranges -1.0-1.0 (left to right)
+
+  float mFuel[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];               // amount of fuel (liters)
+  float mFuelCapacity[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];       // capacity in liters
+
+  signed char mGear[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];         // -1=reverse, 0=neutral, 1+=forward gears
+  unsigned char mMaxGears[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];   // maximum forward gears
+};
+
+
+// Groups of rF2VehicleTelemetry fields that can be requested in a projection (see rF2TelemetryProjectionControl).
+// Each group is a contiguous range of rF2VehicleTelemetry, between the listed first member and the first member of the next group.
+enum class rF2TelemetryFieldGroup : unsigned long
+{
+  Time = 1,                      // mID ... mLapStartET
+  Names = 2,                     // mVehicleName, mTrackName
+  Position = 4,                  // mPos, mLocalVel, mLocalAccel
+  Orientation = 8,               // mOri, mLocalRot, mLocalRotAccel
+  VehicleStatus = 16,            // mGear ... mClutchRPM
+  UnfilteredInput = 32,          // mUnfilteredThrottle ... mUnfilteredClutch
+  FilteredInput = 64,            // mFilteredThrottle ... mFilteredClutch
+  Misc = 128,                    // mSteeringShaftTorque ... mRear3rdDeflection
+  Aerodynamics = 256,            // mFrontWingHeight ... mRearDownforce
+  StateDamage = 512,             // mFuel ... mLastImpactPos
+  Expanded = 1024,               // mEngineTorque ... mElectricBoostMotorState
+  Wheels = 2048,                 // mWheels
+  All = 4095
+};
+
+
+// Packed telemetry of a single projection.  Record of vehicle i (same order as rF2Telemetry::mVehicles) starts at
+// mRecords[i * mRecordSize], and consists of the requested rF2TelemetryFieldGroup ranges of rF2VehicleTelemetry copied as is,
+// in the increasing group flag order, without any padding in between (so fields might be unaligned).
+struct rF2TelemetryProjection
+{
+  unsigned long mFieldGroupsMask;           // rF2TelemetryFieldGroup flags of this projection.  0 means projection is not active.
+  long mRecordSize;                         // Size of the single vehicle record in bytes.
+  long mNumVehicles;                        // Number of vehicle records.
+  double mElapsedTime;                      // Game ET of the frame (min mElapsedTime of vehicles in the frame).
+
+  unsigned char mRecords[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES * sizeof(rF2VehicleTelemetry)];
+};
+
+
+// Client requested subsets of rF2Telemetry, filled from each completed Telemetry frame.  Reader of a single projection only needs to
+// copy the version block, rF2TelemetryProjection header and mNumVehicles * mRecordSize bytes of records.
+struct rF2TelemetryProjections : public rF2MappedBufferHeaderWithSize
+{
+  static int const MAX_PROJECTIONS = 4;
+
+  rF2TelemetryProjection mProjections[rF2TelemetryProjections::MAX_PROJECTIONS];
+};
+
+
+// Player vehicle telemetry, written on every UpdateTelemetry call game makes for the player vehicle.  Bypasses telemetry frame
+// assembly, so it is not limited to the 50FPS rF2Telemetry is updated at.  Player vehicle is the one with mIsPlayer set in the
+// last Scoring update.
+struct rF2PlayerTelemetry : public rF2MappedBufferHeader
+{
+  ULONGLONG mTimestamp;                     // When the update was received.  Same time base as rF2MappedBufferPublishStamp::mTimestamp.
+  rF2VehicleTelemetry mVehicle;             // Player vehicle telemetry.
+};
+
+
+// Vehicle motion dead reckoned from its last telemetry update to rF2Extrapolation::mElapsedTime.
+struct rF2VehicleExtrapolation
+{
+  long mID;                                 // slot ID
+  double mExtrapolationTime;                // Seconds extrapolated past the vehicle's last telemetry update.
+  rF2Vec3 mPos;                             // predicted world position in meters
+  rF2Vec3 mWorldVel;                        // predicted velocity (meters/sec) in world coordinates
+  rF2Vec3 mOri[3];                          // predicted rows of orientation matrix (same convention as rF2VehicleTelemetry::mOri)
+};
+
+
+// Positions and orientations of all vehicles predicted from the last completed telemetry frame, refreshed on each UpdateGraphics
+// call.  Vehicle i is in the same order as rF2Telemetry::mVehicles of that frame.  Extrapolation is capped, so vehicles stop
+// moving if telemetry stops coming in (or game is paused).
+struct rF2Extrapolation : public rF2MappedBufferHeaderWithSize
+{
+  ULONGLONG mTimestamp;                     // Prediction time.  QueryPerformanceCounter value when the prediction was made.
+  double mElapsedTime;                      // Game ET the prediction is for.
+  double mSourceElapsedTime;                // Game ET of the telemetry frame extrapolated from.
+  long mNumVehicles;                        // Number of valid entries in mVehicles.
+
+  rF2VehicleExtrapolation mVehicles[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];
 };
 
 
@@ -887,6 +1111,18 @@ struct rF2Scoring : public rF2MappedBufferHeaderWithSize
 {
   rF2ScoringInfo mScoringInfo;
   rF2VehicleScoring mVehicles[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];
+
+  // MM_NEW
+  // Bit (i % 8) of byte (i / 8) is set if mVehicles[i] changed since the previous update.  Only valid if previous update was read,
+  // so readers that skipped an update (mVersionUpdateBegin moved by more than one) need to copy all the vehicles.
+  unsigned char mVehicleChangedBits[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES / 8];
+
+  // MM_NEW
+  // mID to mVehicles index map of this update.
+  rF2VehicleIDIndex mVehicleIDIndex;
+
+  // mVehicles indices sorted by mPlace (first mScoringInfo.mNumVehicles are valid).
+  unsigned char mPlaceOrder[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];
 };
 
 
@@ -933,6 +1169,18 @@ struct rF2TrackedDamage
 };
 
 
+// Impact captured from vehicle telemetry, see rF2Extended::mImpacts.
+struct rF2ImpactRecord
+{
+  unsigned long mSequence;                    // Sequence number of the impact held in this slot.  0 if slot is empty.
+  long mID;                                   // slot ID of the vehicle
+  double mLastImpactET;                       // time of impact
+  double mLastImpactMagnitude;                // magnitude of impact
+  rF2Vec3 mLastImpactPos;                     // location of impact
+  unsigned char mDentSeverity[8];             // dent severity at 8 locations around the car, as of the telemetry update impact was seen in (0=none, 1=some, 2=more)
+};
+
+
 struct rF2VehScoringCapture
 {
   // VehicleScoringInfoV01 members:
@@ -962,10 +1210,27 @@ struct rF2Weather : public rF2MappedBufferHeader
 };
 
 
+// Sections of rF2Extended, see rF2Extended::mSectionVersions.  Each section is a contiguous range of rF2Extended, between the
+// listed first member and the first member of the next section.
+enum class rF2ExtendedSection : unsigned long
+{
+  Physics = 1,                   // mVersion ... mPhysics
+  Damage = 2,                    // mTrackedDamages
+  CallbackFlags = 4,             // mInRealtimeFC ... mTicksSessionEnded
+  SessionCapture = 8,            // mSessionTransitionCapture
+  PluginState = 16,              // mDisplayedMessageUpdateCapture ... mEventDrivenInputBuffers (messages, DMA and plugin state)
+  Impacts = 32,                  // mLastImpactSequence ... mImpacts
+  All = 63
+};
+
+
 struct rF2Extended : public rF2MappedBufferHeader
 {
   static int const MAX_MAPPED_IDS = 512;
+  static int const NUM_SECTIONS = 6;
+  static int const MAX_IMPACTS = 256;
   static int const MAX_STATUS_MSG_LEN = 128;
+  static int const MAX_DISPLAYED_MESSAGE_LEN = 128;
   static int const MAX_RULES_INSTRUCTION_MSG_LEN = 96;
 
   char mVersion[12];                           // API version
@@ -974,7 +1239,8 @@ struct rF2Extended : public rF2MappedBufferHeader
   // Physics options (updated on session start):
   rF2PhysicsOptions mPhysics;
 
-  // Damage tracking for each vehicle (indexed by mID % rF2Extended::MAX_MAPPED_IDS):
+  // Damage tracking for each vehicle (indexed by mID % rF2Extended::MAX_MAPPED_IDS, unless that slot is taken by
+  // another mID, in which case one of the following slots is used):
   rF2TrackedDamage mTrackedDamages[rF2Extended::MAX_MAPPED_IDS];
 
   // Function call based flags:
@@ -986,11 +1252,11 @@ struct rF2Extended : public rF2MappedBufferHeader
   ULONGLONG mTicksSessionStarted;             // Ticks when session started.
   ULONGLONG mTicksSessionEnded;               // Ticks when session ended.
 
-  // FUTURE: It might be worth to keep the whole scoring capture as a separate double buffer instead of this.
+  // See also rF2SessionTransition buffer, which keeps the complete Scoring and Rules capture.
   rF2SessionTransitionCapture mSessionTransitionCapture;  // Contains partial internals capture at session transition time.
 
   // Captured non-empty MessageInfoV01::mText message.
-  char mDisplayedMessageUpdateCapture[sizeof(decltype(MessageInfoV01::mText))];
+  char mDisplayedMessageUpdateCapture[rF2Extended::MAX_DISPLAYED_MESSAGE_LEN];
 
   // Direct Memory access stuff
   bool mDirectMemoryAccessEnabled;
@@ -1024,7 +1290,30 @@ struct rF2Extended : public rF2MappedBufferHeader
   bool mWeatherControlInputEnabled;               // Weather Control input buffer is enabled.
   bool mRulesControlInputEnabled;                 // Rules Control input buffer is enabled.
   bool mPluginControlInputEnabled;                // Plugin Control input buffer is enabled.
+
+  long mTripleBufferedBuffersMask;                // Currently active TripleBufferedBuffersMask value.  Buffers in this mask are mapped in the triple buffered layout (see rF2MappedBufferSlotBlock).
+  long mUpdateNotificationBuffersMask;            // Currently active UpdateNotificationBuffersMask value.  Buffers in this mask signal each completed update.
+  long mCacheLineIsolatedBuffersMask;             // Currently active CacheLineIsolatedBuffersMask value.  Buffers in this mask are mapped in the cache line isolated layout (see rF2MappedBufferLayout).
+  long mLargePagesBuffersMask;                    // Buffers actually backed by large pages.  Subset of LargePagesBuffersMask value, large pages might not be available.
+  long mSuspendIdleBuffersMask;                   // Currently active SuspendIdleBuffersMask value.  Buffers in this mask are not updated while no client reads them (see rF2ReaderRegistry).
+  long mSuspendedBuffersMask;                     // Buffers currently not updated because no live client registered for them.
+
+  bool mEventDrivenInputBuffers;                  // Input buffers are also checked in the callbacks applying them, so publish is picked up on the next callback.
+
+  // MM_NEW
+  // Incremented each time section is published, indexed by rF2ExtendedSection flag bit.  Plugin only writes sections that changed,
+  // so clients can copy the version block and mSectionVersions, then only the sections whose version changed, and re-check the
+  // version block.
+  unsigned long mSectionVersions[rF2Extended::NUM_SECTIONS];
+
+  // MM_NEW
+  // Ring of the last impacts of all vehicles.  mTrackedDamages only keeps totals, this keeps each hit.  Impact with sequence
+  // number N is at mImpacts[N % rF2Extended::MAX_IMPACTS].  Captured on every telemetry update, published along with Scoring.
+  // Not cleared on session restart, so that readers can keep the sequence numbers.
+  unsigned long mLastImpactSequence;                // Sequence number of the last impact, starts at 1.  0 means no impacts recorded.
+  rF2ImpactRecord mImpacts[rF2Extended::MAX_IMPACTS];
 };
+RF2_SDK_LAYOUT_CHECK(rF2Extended::MAX_DISPLAYED_MESSAGE_LEN == sizeof(decltype(MessageInfoV01::mText)), "rF2Extended::MAX_DISPLAYED_MESSAGE_LEN does not match MessageInfoV01::mText");
 
 
 struct rF2MappedInputBufferHeader : public rF2MappedBufferHeader
@@ -1032,15 +1321,51 @@ struct rF2MappedInputBufferHeader : public rF2MappedBufferHeader
   long mLayoutVersion;
 };
 
-struct rF2HWControl : public rF2MappedInputBufferHeader
+struct rF2HWControlCommand
 {
   static int const MAX_HWCONTROL_NAME_LEN = 96;
 
+  char mControlName[rF2HWControlCommand::MAX_HWCONTROL_NAME_LEN];
+  double mfRetVal;
+};
+
+
+// Layout version 1: client writes a single command into mControlName/mfRetVal using the version block.  Plugin polls at 5FPS
+// (50FPS for 500ms after a hit), so commands sent in quick succession might get lost.
+//
+// Layout version 2 adds single producer single consumer queue of commands, drained by the plugin every frame.  Client sets
+// mLayoutVersion to 2 once (using the version block), then, without touching the version block:
+//   - Checks that mQueueWriteIndex - mQueueReadIndex < MAX_QUEUED_COMMANDS (queue is not full).
+//   - Writes command into mQueue[mQueueWriteIndex % MAX_QUEUED_COMMANDS].
+//   - Increments mQueueWriteIndex (with release semantics, after the command is written).
+// Commands are applied in order, one per frame (100FPS).  Command that does not match any control within 500ms is dropped.
+// Note: layout version 1 clients must not write past mfRetVal.
+struct rF2HWControl : public rF2MappedInputBufferHeader
+{
+  static int const MAX_HWCONTROL_NAME_LEN = rF2HWControlCommand::MAX_HWCONTROL_NAME_LEN;
+  static unsigned long const MAX_QUEUED_COMMANDS = 64uL;
+
   // Version supported by the _current_ plugin.
-  static long const SUPPORTED_LAYOUT_VERSION = 1L;
+  static long const SUPPORTED_LAYOUT_VERSION = 2L;
 
   char mControlName[rF2HWControl::MAX_HWCONTROL_NAME_LEN];
   double mfRetVal;
+
+  // Layout version 2:
+  unsigned long mQueueWriteIndex;                 // Written by the client.  Count of commands ever queued.
+  unsigned long mQueueReadIndex;                  // Written by the plugin.  Count of commands ever consumed.
+  rF2HWControlCommand mQueue[rF2HWControl::MAX_QUEUED_COMMANDS];
+};
+
+
+// Names of the controls game checks via CheckHWControl, that is, names rF2HWControl accepts.  Plugin learns them during
+// the first frames after HWControl input is enabled, and appends names game starts checking later.
+struct rF2HWControlNames : public rF2MappedBufferHeader
+{
+  static int const MAX_HWCONTROLS = 1024;
+
+  long mNumControls;
+  char mControlNames[rF2HWControlNames::MAX_HWCONTROLS][rF2HWControlCommand::MAX_HWCONTROL_NAME_LEN];
 };
 
 
@@ -1078,4 +1403,181 @@ struct rF2PluginControl : public rF2MappedInputBufferHeader
 };
 
 
+// Sets (or, if mFieldGroupsMask is 0, clears) projection mProjectionIndex of the rF2TelemetryProjections buffer.
+struct rF2TelemetryProjectionControl : public rF2MappedInputBufferHeader
+{
+  // Version supported by the _current_ plugin.
+  static long const SUPPORTED_LAYOUT_VERSION = 1L;
+
+  long mProjectionIndex;                    // [0, rF2TelemetryProjections::MAX_PROJECTIONS)
+  unsigned long mFieldGroupsMask;           // rF2TelemetryFieldGroup flags.
+};
+
+
+struct rF2ReaderSlot
+{
+  unsigned long mProcessId;                 // Process ID of the client owning this slot.  0 means slot is free.
+  long mBuffersMask;                        // SubscribedBuffer flags of the buffers client reads.
+  unsigned long mHeartbeat;                 // Incremented by the client while it is alive.
+};
+
+
+// Registry of the clients reading output buffers.  Buffers in the SuspendIdleBuffersMask are not updated while no live client
+// has them in its mBuffersMask (see rF2Extended::mSuspendedBuffersMask).  Unlike other buffers, this one is written by the clients:
+//   - Claim a free slot with interlocked compare exchange of mProcessId from 0 to the client PID.
+//   - Set mBuffersMask, and increment mHeartbeat at least every HEARTBEAT_TIMEOUT_MS / 2 milliseconds.  Before that, check that
+//     mProcessId still equals client PID.  If it does not, slot was reclaimed by the plugin, claim a new one.
+//   - On exit, set mBuffersMask to 0, and mProcessId to 0.
+// Client is considered dead if mHeartbeat did not change for HEARTBEAT_TIMEOUT_MS, and its slot is freed after RECLAIM_TIMEOUT_MS.
+// Registry is also cleared on plugin start, so clients that outlive a game restart re-claim their slot the same way.
+// Note that suspended buffer resumes within about 200ms of the first heartbeat, and until the next update contains the old data.
+struct rF2ReaderRegistry : public rF2MappedBufferHeader
+{
+  static int const MAX_READERS = 32;
+  static unsigned long const HEARTBEAT_TIMEOUT_MS = 2000uL;
+  static unsigned long const RECLAIM_TIMEOUT_MS = 30000uL;
+
+  rF2ReaderSlot mReaders[rF2ReaderRegistry::MAX_READERS];
+};
+
+
+// Update statistics of a single output buffer.  Histograms are in log2 buckets of microseconds: bucket 0 counts values below
+// 1us, bucket i counts values in [2^(i-1), 2^i) us, and the last bucket counts everything above.
+struct rF2BufferStatistics
+{
+  static int const NUM_HISTOGRAM_BUCKETS = 24;
+
+  unsigned long mNumUpdates;                                                    // Updates published since plugin startup.
+  ULONGLONG mLastPublishTimestamp;                                              // rF2MappedBufferPublishStamp::mTimestamp of the last update.
+  double mLastPublishElapsedTime;                                               // rF2MappedBufferPublishStamp::mElapsedTime of the last update.
+  double mMaxUpdateMicroseconds;                                                // Max time plugin spent writing an update.
+  double mMaxIntervalMicroseconds;                                              // Max time between two publishes.
+  unsigned long mUpdateHistogram[rF2BufferStatistics::NUM_HISTOGRAM_BUCKETS];    // Time plugin spent writing an update.  For Telemetry, this is the
+                                                                                //   time spent inside of the UpdateTelemetry calls assembling the frame.
+  unsigned long mIntervalHistogram[rF2BufferStatistics::NUM_HISTOGRAM_BUCKETS];  // Time between two publishes.
+};
+
+
+// Update statistics of the output buffers, so that plugin induced latency can be monitored without the debug output.
+// Updated at 5FPS (along with Scoring).
+struct rF2Statistics : public rF2MappedBufferHeader
+{
+  static int const MAX_BUFFERS = 16;
+
+  ULONGLONG mTimestampFrequency;                                    // Timestamp ticks per second.
+  rF2BufferStatistics mBuffers[rF2Statistics::MAX_BUFFERS];          // Indexed by SubscribedBuffer flag bit: Telemetry is 0, Scoring is 1, Rules is 2...
+                                                                    //   ForceFeedback and Graphics are not versioned, so they have no statistics.
+};
+
+
+// Complete Scoring and Rules state captured on a session transition.  Mirrors game data of rF2Scoring and rF2Rules, plugin
+// computed members (mBytesUpdatedHint, mVehicleChangedBits and so on) are not captured.
+struct rF2SessionTransitionFrame
+{
+  unsigned long mSequence;                  // Sequence number of the capture (shared by both frames of rF2SessionTransition).  0 if nothing captured yet.
+  ULONGLONG mTicksCaptured;                 // Ticks when captured, same as rF2Extended::mTicksSessionStarted/mTicksSessionEnded.
+
+  rF2ScoringInfo mScoringInfo;              // Last Scoring update before the transition.
+  rF2VehicleScoring mScoringVehicles[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];
+
+  rF2TrackRules mTrackRules;                // Last Rules update before the transition.
+  rF2TrackRulesAction mRulesActions[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];
+  rF2TrackRulesParticipant mRulesParticipants[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];
+};
+
+
+// Scoring and Rules captured on the last EndSession and StartSession calls, so that final classification can be read after
+// the next session started updating Scoring.  Updated only on session transitions, and not cleared on session restart.
+struct rF2SessionTransition : public rF2MappedBufferHeader
+{
+  unsigned long mLastSequence;                    // Sequence number of the last capture.
+  rF2SessionTransitionFrame mSessionEnd;          // Captured on the last EndSession call.
+  rF2SessionTransitionFrame mSessionStart;        // Captured on the last StartSession call.  Game sometimes sends updates (including final
+                                                  //   qualification positions) between EndSession and StartSession, so this might be more complete.
+};
+
+
+// State transitions detected by comparing consecutive Scoring updates.  mOldValue/mNewValue hold the compared member values.
+enum class rF2EventType : long
+{
+  PitEntered = 1,                // mInPits became true
+  PitExited = 2,                 // mInPits became false
+  PitStateChanged = 3,           // mPitState
+  FlagChanged = 4,               // mFlag (vehicle)
+  LapCompleted = 5,              // mTotalLaps increased
+  PenaltiesChanged = 6,          // mNumPenalties
+  FinishStatusChanged = 7,       // mFinishStatus
+  GamePhaseChanged = 8,          // mGamePhase (session)
+  SessionChanged = 9,            // mSession (session)
+  YellowFlagStateChanged = 10,   // mYellowFlagState (session)
+  SectorFlagChanged = 11         // mSectorFlag[mIndex] (session)
+};
+
+
+struct rF2Event
+{
+  unsigned long mSequence;                  // Sequence number of the event held in this slot.  0 while slot is empty or being written to.
+  long mType;                               // rF2EventType
+  double mElapsedTime;                      // mCurrentET of the Scoring update transition was detected in.
+  long mID;                                 // Vehicle mID, -1 for session events.
+  long mIndex;                              // mVehicles index of the vehicle in that Scoring update, or sector index for SectorFlagChanged, -1 otherwise.
+  long mOldValue;
+  long mNewValue;
+};
+
+
+// Ring of events detected in Scoring updates, so that clients do not have to diff Scoring updates themselves.  Event with sequence
+// number N is at mEvents[N % MAX_EVENTS].  Read protocol is the same as rF2TelemetryHistory: read mLastSequence, copy events
+// past the last one read, and check mSequence of each copied event is still the expected one.  If mLastSequence moved by more
+// than MAX_EVENTS since the last read, events were lost.  Not cleared on session restart.
+struct rF2EventJournal : public rF2MappedBufferHeader
+{
+  static int const MAX_EVENTS = 1024;
+
+  unsigned long mLastSequence;              // Sequence number of the last event, starts at 1.  0 means no events recorded.
+  rF2Event mEvents[rF2EventJournal::MAX_EVENTS];
+};
+
+
+// Gaps of a vehicle derived from a Scoring update.  Gaps are split into seconds and full laps, same as
+// rF2VehicleScoring::mTimeBehindLeader/mLapsBehindLeader.  IDs are -1 where there's no such vehicle.
+struct rF2VehicleDerivedTiming
+{
+  long mID;                                 // slot ID
+  unsigned char mPlace;                     // 1-based position
+  unsigned char mClassPlace;                // 1-based position within mVehicleClass
+
+  double mTimeBehindLeader;                 // same as rF2VehicleScoring::mTimeBehindLeader
+  long mLapsBehindLeader;
+  double mTimeBehindNext;                   // interval to the vehicle in next higher place, same as rF2VehicleScoring::mTimeBehindNext
+  long mLapsBehindNext;
+
+  long mClassLeaderID;                      // leader of mVehicleClass
+  double mTimeBehindClassLeader;
+  long mLapsBehindClassLeader;
+  long mClassNextID;                        // vehicle in next higher place within mVehicleClass
+  double mTimeBehindClassNext;
+  long mLapsBehindClassNext;
+
+  // Relative on-track gaps, regardless of place.  Vehicles in the garage stall or retired are not considered.
+  double mLapDist;                          // mLapDist interpolated to rF2DerivedTiming::mElapsedTime
+  long mTrackAheadID;                       // nearest vehicle ahead on track
+  double mTrackGapAhead;                    // seconds this vehicle needs to reach mTrackAheadID's position, -1.0 if unknown
+  long mTrackBehindID;                      // nearest vehicle behind on track
+  double mTrackGapBehind;                   // seconds mTrackBehindID needs to reach this vehicle's position, -1.0 if unknown
+};
+
+
+// Gaps and intervals of all vehicles.  Standings are computed once per Scoring update, on-track fields (mLapDist and below)
+// are also refreshed on each completed telemetry frame.  Vehicle i is in the same order as rF2Scoring::mVehicles of that update.
+struct rF2DerivedTiming : public rF2MappedBufferHeaderWithSize
+{
+  double mScoringElapsedTime;               // mCurrentET of the Scoring update gaps are derived from.
+  double mElapsedTime;                      // Game ET on-track positions are interpolated to (telemetry frame ET, or mScoringElapsedTime).
+  long mNumVehicles;                        // Number of valid entries in mVehicles.
+
+  rF2VehicleDerivedTiming mVehicles[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];
+};
+
+
 #pragma pack(pop)
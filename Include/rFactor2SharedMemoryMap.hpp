@@ -47,6 +47,7 @@ Website: thecrewchief.org
 
 #include "rF2State.h"
 #include "MappedBuffer.h"
+#include "MappedIDTable.h"
 #include "DirectMemoryReader.h"
 
 enum class DebugLevel : long
@@ -94,7 +95,14 @@ enum class SubscribedBuffer : long
   Graphics = 32,
   PitInfo = 64,
   Weather = 128,
-  All = 255
+  TelemetryHistory = 256,
+  TelemetryLite = 512,
+  TelemetryProjections = 1024,
+  PlayerTelemetry = 2048,
+  Extrapolation = 4096,
+  EventJournal = 8192,
+  DerivedTiming = 16384,
+  All = 32767
 };
 
 double TicksNow();
@@ -116,12 +124,24 @@ public:
   static char const* const MM_EXTENDED_FILE_NAME;
   static char const* const MM_PIT_INFO_FILE_NAME;
   static char const* const MM_WEATHER_FILE_NAME;
+  static char const* const MM_TELEMETRY_HISTORY_FILE_NAME;
+  static char const* const MM_TELEMETRY_LITE_FILE_NAME;
+  static char const* const MM_TELEMETRY_PROJECTIONS_FILE_NAME;
+  static char const* const MM_PLAYER_TELEMETRY_FILE_NAME;
+  static char const* const MM_EXTRAPOLATION_FILE_NAME;
+  static char const* const MM_READER_REGISTRY_FILE_NAME;
+  static char const* const MM_HWCONTROL_NAMES_FILE_NAME;
+  static char const* const MM_STATISTICS_FILE_NAME;
+  static char const* const MM_SESSION_TRANSITION_FILE_NAME;
+  static char const* const MM_EVENT_JOURNAL_FILE_NAME;
+  static char const* const MM_DERIVED_TIMING_FILE_NAME;
 
   // Input buffers:
   static char const* const MM_HWCONTROL_FILE_NAME;
   static char const* const MM_WEATHER_CONTROL_FILE_NAME;
   static char const* const MM_RULES_CONTROL_FILE_NAME;
   static char const* const MM_PLUGIN_CONTROL_FILE_NAME;
+  static char const* const MM_TELEMETRY_PROJECTION_CONTROL_FILE_NAME;
 
   static char const* const INTERNALS_TELEMETRY_FILENAME;
   static char const* const INTERNALS_SCORING_FILENAME;
@@ -136,6 +156,12 @@ public:
   static bool msDedicatedServerMapGlobally;
   static bool msDirectMemoryAccessRequested;
   static long msUnsubscribedBuffersMask;
+  static long msTripleBufferedBuffersMask;
+  static long msUpdateNotificationBuffersMask;
+  static long msCacheLineIsolatedBuffersMask;
+  static long msLargePagesBuffersMask;
+  static long msSuspendIdleBuffersMask;
+  static bool msEventDrivenInputBuffers;
   static bool msHWControlInputRequested;
   static bool msWeatherControlInputRequested;
   static bool msRulesControlInputRequested;
@@ -163,7 +189,8 @@ private:
   class ExtendedStateTracker
   {
   public:
-    ExtendedStateTracker()
+    explicit ExtendedStateTracker(MappedIDTable& idTable)
+      : mIDTable(idTable)
     {
       // There's a bug somewhere (in my head?), initializing mExtended = {} does not make it all 0.
       // Maybe there's a race between simulation and multimedia threads, but I can't debug due to game crashing on attach.
@@ -172,6 +199,8 @@ private:
 
       static_assert(sizeof(mExtended.mVersion) >= sizeof(SHARED_MEMORY_VERSION), "Invalid plugin version string (too long).");
 
+      memset(mDamageSlotDirty, 0, sizeof(mDamageSlotDirty));
+
       strcpy_s(mExtended.mVersion, SHARED_MEMORY_VERSION);
       mExtended.is64bit = PLUGIN_64BIT;
       mExtended.mSCRPluginDoubleFileType = -1L;
@@ -180,18 +209,22 @@ private:
       assert(!mExtended.mSimulationThreadStarted);
     }
 
-    void ProcessTelemetryUpdate(TelemInfoV01 const& info)
+    // slot is info.mID slot in mIDTable.
+    void ProcessTelemetryUpdate(TelemInfoV01 const& info, long slot)
     {
-      auto const id = max(info.mID, 0L) % rF2Extended::MAX_MAPPED_IDS;
-
-      auto& dti = mDamageTrackingInfos[id];
+      auto& dti = mDamageTrackingInfos[slot];
       if (info.mLastImpactET > dti.mLastPitStopET  // Is this new impact since last pit stop?
         && info.mLastImpactET > dti.mLastImpactProcessedET) { // Is this new impact?
         // Ok, this is either new impact, or first impact since pit stop.
         // Update max and accumulated impact magnitudes.
-        auto& td = mExtended.mTrackedDamages[id];
+        TrackDamagedSlot(slot);
+
+        auto& td = mExtended.mTrackedDamages[slot];
         td.mMaxImpactMagnitude = max(td.mMaxImpactMagnitude, info.mLastImpactMagnitude);
         td.mAccumulatedImpactMagnitude += info.mLastImpactMagnitude;
+        MarkDamageSlotDirty(slot);
+
+        RecordImpact(info);
 
         dti.mLastImpactProcessedET = info.mLastImpactET;
       }
@@ -202,12 +235,18 @@ private:
       for (int i = 0; i < info.mNumVehicles; ++i) {
         if (info.mVehicle[i].mPitState == static_cast<unsigned char>(rF2PitState::Stopped)) {
           // If this car is pitting, clear out any damage tracked.
-          auto const id = max(info.mVehicle[i].mID, 0L) % rF2Extended::MAX_MAPPED_IDS;
+          auto slotAssigned = false;
+          auto const slot = mIDTable.FindOrAdd(info.mVehicle[i].mID, slotAssigned);
+          if (slot == -1L)
+            continue;
+
+          memset(&(mExtended.mTrackedDamages[slot]), 0, sizeof(rF2TrackedDamage));
 
-          memset(&(mExtended.mTrackedDamages[id]), 0, sizeof(rF2TrackedDamage));
+          TrackDamagedSlot(slot);
+          MarkDamageSlotDirty(slot);
 
-          mDamageTrackingInfos[id].mLastImpactProcessedET = 0.0;
-          mDamageTrackingInfos[id].mLastPitStopET = info.mCurrentET;
+          mDamageTrackingInfos[slot].mLastImpactProcessedET = 0.0;
+          mDamageTrackingInfos[slot].mLastPitStopET = info.mCurrentET;
         }
       }
     }
@@ -239,21 +278,130 @@ private:
 
     void ResetDamageState()
     {
-      memset(&(mExtended.mTrackedDamages), 0, sizeof(mExtended.mTrackedDamages));
-      memset(&mDamageTrackingInfos, 0, sizeof(mDamageTrackingInfos));
+      // Only reset entries that were touched, there are rarely more than a few dozen of them.
+      for (int i = 0; i < mNumDamagedSlots; ++i) {
+        auto const slot = mDamagedSlots[i];
+
+        memset(&(mExtended.mTrackedDamages[slot]), 0, sizeof(rF2TrackedDamage));
+        memset(&(mDamageTrackingInfos[slot]), 0, sizeof(DamageTracking));
+        MarkDamageSlotDirty(slot);
+      }
+
+      mNumDamagedSlots = 0;
+    }
+
+    // Called when mIDTable slot is taken over by another mID, previous owner's damage must not carry over.
+    void ResetSlotDamageState(long slot)
+    {
+      auto& dti = mDamageTrackingInfos[slot];
+      if (!dti.mTracked)
+        return;  // Nothing to reset.
+
+      memset(&(mExtended.mTrackedDamages[slot]), 0, sizeof(rF2TrackedDamage));
+      MarkDamageSlotDirty(slot);
+
+      // Slot stays in mDamagedSlots.
+      dti.mLastImpactProcessedET = 0.0;
+      dti.mLastPitStopET = 0.0;
+    }
+
+    // Copies mTrackedDamages entries changed since the last call into pDest.  pDest is nullptr if whole mExtended was published.
+    void FlushDirtyDamageSlots(rF2Extended* pDest)
+    {
+      for (int i = 0; i < mNumDirtyDamageSlots; ++i) {
+        auto const slot = mDirtyDamageSlots[i];
+
+        if (pDest != nullptr)
+          pDest->mTrackedDamages[slot] = mExtended.mTrackedDamages[slot];
+
+        mDamageSlotDirty[slot] = false;
+      }
+
+      mNumDirtyDamageSlots = 0;
+    }
+
+    bool HasUnpublishedImpacts() const { return mExtended.mLastImpactSequence != mPublishedImpactSequence; }
+
+    // Copies mImpacts entries recorded since the last call into pDest.  pDest is nullptr if whole mExtended was published.
+    void FlushImpacts(rF2Extended* pDest)
+    {
+      if (pDest != nullptr) {
+        auto const numNew = min(mExtended.mLastImpactSequence - mPublishedImpactSequence, static_cast<unsigned long>(rF2Extended::MAX_IMPACTS));
+        for (auto sequence = mExtended.mLastImpactSequence - numNew + 1uL; sequence != mExtended.mLastImpactSequence + 1uL; ++sequence) {
+          auto const i = sequence % rF2Extended::MAX_IMPACTS;
+          pDest->mImpacts[i] = mExtended.mImpacts[i];
+        }
+
+        pDest->mLastImpactSequence = mExtended.mLastImpactSequence;
+      }
+
+      mPublishedImpactSequence = mExtended.mLastImpactSequence;
     }
 
   public:
     rF2Extended mExtended = {};
 
   private:
+    void TrackDamagedSlot(long slot)
+    {
+      auto& dti = mDamageTrackingInfos[slot];
+      if (dti.mTracked)
+        return;
+
+      assert(mNumDamagedSlots < rF2Extended::MAX_MAPPED_IDS);
+      mDamagedSlots[mNumDamagedSlots++] = slot;
+      dti.mTracked = true;
+    }
+
+    void MarkDamageSlotDirty(long slot)
+    {
+      if (mDamageSlotDirty[slot])
+        return;
+
+      assert(mNumDirtyDamageSlots < rF2Extended::MAX_MAPPED_IDS);
+      mDirtyDamageSlots[mNumDirtyDamageSlots++] = slot;
+      mDamageSlotDirty[slot] = true;
+    }
+
+    void RecordImpact(TelemInfoV01 const& info)
+    {
+      auto const sequence = mExtended.mLastImpactSequence + 1uL;
+      auto& impact = mExtended.mImpacts[sequence % rF2Extended::MAX_IMPACTS];
+
+      impact.mSequence = sequence;
+      impact.mID = info.mID;
+      impact.mLastImpactET = info.mLastImpactET;
+      impact.mLastImpactMagnitude = info.mLastImpactMagnitude;
+      memcpy(&(impact.mLastImpactPos), &(info.mLastImpactPos), sizeof(rF2Vec3));
+      memcpy(impact.mDentSeverity, info.mDentSeverity, sizeof(impact.mDentSeverity));
+
+      mExtended.mLastImpactSequence = sequence;
+    }
+
     struct DamageTracking
     {
       double mLastImpactProcessedET = 0.0;
       double mLastPitStopET = 0.0;
+      bool mTracked = false;  // Slot is in mDamagedSlots.
     };
 
+    // Shared with the telemetry frame assembly, see SharedMemoryPlugin::mIDTable.
+    MappedIDTable& mIDTable;
+
+    // Indexed by mIDTable slot.
     DamageTracking mDamageTrackingInfos[rF2Extended::MAX_MAPPED_IDS];
+
+    // Slots with non-zero damage tracking state, so that ResetDamageState does not have to clear all MAX_MAPPED_IDS entries.
+    long mDamagedSlots[rF2Extended::MAX_MAPPED_IDS];
+    int mNumDamagedSlots = 0;
+
+    // Slots with mTrackedDamages entry changed since the last publish, so that damage is published without copying the whole array.
+    long mDirtyDamageSlots[rF2Extended::MAX_MAPPED_IDS];
+    bool mDamageSlotDirty[rF2Extended::MAX_MAPPED_IDS];
+    int mNumDirtyDamageSlots = 0;
+
+    // mLastImpactSequence as of the last publish.
+    unsigned long mPublishedImpactSequence = 0uL;
   };
 
 public:
@@ -305,7 +453,8 @@ public:
   void GetCustomVariableSetting(CustomVariableV01& var, long i, CustomSettingV01& setting) override; // This gets the name of each possible setting for a given variable.
 
   // GRAPHICS
-  bool WantsGraphicsUpdates() override { return Utils::IsFlagOff(SharedMemoryPlugin::msUnsubscribedBuffersMask, SubscribedBuffer::Graphics); }       // whether we want graphics updates
+  bool WantsGraphicsUpdates() override { return Utils::IsFlagOff(SharedMemoryPlugin::msUnsubscribedBuffersMask, SubscribedBuffer::Graphics)
+    || Utils::IsFlagOff(SharedMemoryPlugin::msUnsubscribedBuffersMask, SubscribedBuffer::Extrapolation); }       // whether we want graphics updates
   void UpdateGraphics(GraphicsInfoV02 const& info) override;  // update plugin with graphics info
 
   // Supress C4266.
@@ -318,9 +467,21 @@ public:
   // HW Control- action a control within the game
   bool HasHardwareInputs() override
   {
-    return SharedMemoryPlugin::msHWControlInputRequested
-      && mExtStateTracker.mExtended.mHWControlInputEnabled
-      && SharedMemoryPlugin::mHWControlInputRequestReceived;
+    if (!SharedMemoryPlugin::msHWControlInputRequested
+      || !mExtStateTracker.mExtended.mHWControlInputEnabled)
+      return false;
+
+    // Ask for CheckHWControl calls during the first frames even if there's no input, so that control names get learned.
+    auto const learning = mHWControlLearnFramesLeft > 0;
+    UpdateHWControlNames();
+
+    if (SharedMemoryPlugin::msEventDrivenInputBuffers)
+      ReadHWControlBuffer(false /*boosted*/);
+
+    if (mHWControlQueueEnabled)
+      ReadHWControlQueue();
+
+    return SharedMemoryPlugin::mHWControlInputRequestReceived || learning;
   }
 
   bool CheckHWControl(char const* const controlName, double& fRetVal) override;
@@ -350,15 +511,43 @@ private:
   void TelemetryTraceEndUpdate(int numVehiclesInChain);
   void TelemetryBeginNewFrame(TelemInfoV01 const& info, double deltaET);
   void TelemetryCompleteFrame();
+  void TelemetryUpdateFrame(TelemInfoV01 const& info);
+  void TelemetryHistoryAppendFrame();
+  void TelemetryLiteUpdate();
+  void TelemetryProjectionsUpdate();
+  void PlayerTelemetryUpdate(TelemInfoV01 const& info);
+  void ExtrapolationCaptureFrame();
+  void ExtrapolationUpdate();
+  void ExtrapolationPublishStatistics();
 
   void ScoringTraceBeginUpdate();
+  void RulesUpdate(TrackRulesV01 const& info);
   void ReadDMROnScoringUpdate(ScoringInfoV01 const& info);
   void ReadHWControl();
+  void ReadHWControlBuffer(bool boosted);
+  void ReadHWControlQueue();
+  void LoadQueuedHWControlCommand();
+  void PopQueuedHWControlCommand();
+  long FindHWControl(char const* const controlName) const;
+  long AddHWControl(char const* const controlName);
+  long ResolveHWControl(char const* const controlName);
+  void UpdateHWControlNames();
   void ReadWeatherControl();
   void ReadRulesControl();
   void DynamicallySubscribeToBuffer(SubscribedBuffer sb, long requestedBuffMask, const char* const buffLogicalName);
   void DynamicallyEnableInputBuffer(bool dependencyMissing, bool& controlInputRequested, bool& controlIputEnabled, char const* const buffLogicalName);
   void ReadPluginControl();
+  void ReadTelemetryProjectionControl();
+  void ReadReaderRegistry();
+  void StatisticsUpdate();
+  void ExtendedUpdate(unsigned long sectionsMask);
+  void SessionTransitionUpdate(bool sessionEnded);
+  void EventJournalUpdate(ScoringInfoV01 const& info);
+  void EventJournalAppend(rF2EventType type, double elapsedTime, long id, long index, long oldValue, long newValue, bool& updateBegun);
+  void DerivedTimingUpdate(rF2Scoring const& scoring);
+  void DerivedTimingPublish();
+  void MarkExtendedSectionsUpdated(unsigned long sectionsMask);
+  bool IsBufferSuspended(SubscribedBuffer sb) const { return Utils::IsFlagOn(mExtStateTracker.mExtended.mSuspendedBuffersMask, sb); }
   bool IsHWControlInputDependencyMissing();
   bool IsWeatherControlInputDependencyMissing();
   bool IsRulesControlInputDependencyMissing();
@@ -374,6 +563,8 @@ private:
   double mLastRulesUpdateMillis = 0.0;
   double mLastMultiRulesUpdateMillis = 0.0;
 
+  // mID to slot map used for telemetry frame assembly and damage tracking.  Must be declared before mExtStateTracker.
+  MappedIDTable mIDTable;
   ExtendedStateTracker mExtStateTracker;
 
   // Elapsed times reported by the game.
@@ -385,12 +576,8 @@ private:
   bool mTelemetryFrameCompleted = true;
   bool mTelemetrySkipFrameReported = false;
   int mCurrTelemetryVehicleIndex = 0;
-  // Array used to track if mID telemetry is captured for this update.
-  // Indexed by mID % rF2MappedBufferHeader::MAX_MAPPED_IDS, so will break down if max(mID) - min(mID) in a frame >= rF2MappedBufferHeader::MAX_MAPPED_IDS
-  // If this becomes a problem (people complain), different mechanism will be necessary.
-  // One way to handle this is to take first mID in a telemetry frame, and use it as a starting offset.
-  // This might be fine, because game appears to be sending mIDs in an ascending order.
-  bool mParticipantTelemetryUpdated[rF2Extended::MAX_MAPPED_IDS];
+  // Whether mID telemetry is captured for this update is tracked by stamping its slot in mIDTable.  Generation
+  // advances with each frame, so nothing needs to be cleared per frame.
 
   // Pit menu update trackers.
   long mPitMenuLastCategoryIndex = -1L;
@@ -404,9 +591,112 @@ private:
   int mHWControlRequestBoostCounter = 0;
 
   bool mHWControlInputRequestReceived = false;
+
+  // Command pending to be applied in CheckHWControl, either read from the layout version 1 buffer or the head of the queue.
+  rF2HWControlCommand mHWControlCommand = {};
+  bool mHWControlQueueEnabled = false;
+  bool mHWControlCommandQueued = false;
+  // Number of HasHardwareInputs calls queued command has been pending for.
+  int mHWControlQueueStallCounter = 0;
+  // Index of mHWControlCommand in mHWControlNamesState, -1 if not learned.
+  long mHWControlCommandIndex = -1L;
+
+  // Control names game checks in CheckHWControl, and open addressing hash tables resolving them to the index in
+  // mHWControlNamesState.mControlNames: one by case insensitive name, the other one by the name pointer game passes in.
+  // Game passes the same pointers every frame, so after the first HWCONTROL_LEARN_FRAMES frames (during which pointers
+  // are verified against the names), each CheckHWControl call resolves the control with a pointer hash lookup.
+  static int const HWCONTROL_LEARN_FRAMES = 3;
+  static int const HWCONTROL_HASH_TABLE_SIZE = 4 * rF2HWControlNames::MAX_HWCONTROLS;  // Power of two.
+  rF2HWControlNames mHWControlNamesState = {};
+  long mHWControlNameBuckets[HWCONTROL_HASH_TABLE_SIZE];
+  char const* mHWControlPointerKeys[HWCONTROL_HASH_TABLE_SIZE];
+  long mHWControlPointerBuckets[HWCONTROL_HASH_TABLE_SIZE];
+  int mNumHWControlPointers = 0;
+  bool mHWControlPointersStable = true;
+  bool mHWControlNamesChanged = false;
+  int mHWControlLearnFramesLeft = HWCONTROL_LEARN_FRAMES;
   bool mWeatherControlInputRequestReceived = false;
   bool mRulesControlInputRequestReceived = false;
 
+  // rF2TelemetryFieldGroup flags of each projection requested via rF2TelemetryProjectionControl.
+  unsigned long mTelemetryProjectionMasks[rF2TelemetryProjections::MAX_PROJECTIONS];
+
+  // mID of the player vehicle in the last Scoring update, -1 if there's none.
+  long mPlayerTelemetryID = -1L;
+
+  // Session values of the last Scoring update, compared by EventJournalUpdate.  Unlike the Scoring buffer, not cleared on session
+  // restart, so that session changes are journaled.
+  struct EventJournalSessionState
+  {
+    bool mValid;
+    long mSession;
+    unsigned char mGamePhase;
+    signed char mYellowFlagState;
+    signed char mSectorFlags[3];
+  };
+
+  EventJournalSessionState mEventJournalSessionState = {};
+
+  // Motion state of a vehicle in a completed telemetry frame, see ExtrapolationUpdate.
+  struct VehicleMotion
+  {
+    long mID;
+    double mElapsedTime;
+    rF2Vec3 mPos;
+    rF2Vec3 mLocalVel;
+    rF2Vec3 mLocalAccel;
+    rF2Vec3 mOri[3];
+    rF2Vec3 mLocalRot;
+  };
+
+  static void ExtrapolateVehicleMotion(VehicleMotion const& motion, double dt, rF2VehicleExtrapolation& vehicle);
+
+  // Vehicles of a completed telemetry frame, captured on the simulation thread.
+  struct ExtrapolationSnapshot
+  {
+    VehicleMotion mVehicles[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];
+    long mNumVehicles;
+    double mSourceET;
+    ULONGLONG mTimestamp;
+  };
+
+  // Snapshots are handed from the simulation thread to the multimedia thread via triple buffering: each thread owns one
+  // snapshot, and swaps it with the latest one.  EXTRAPOLATION_SNAPSHOT_FRESH is set in mExtrapolationLatestSlot until the
+  // multimedia thread takes the snapshot.
+  static unsigned long const EXTRAPOLATION_SNAPSHOT_FRESH = 0x4uL;
+  ExtrapolationSnapshot mExtrapolationSnapshots[3];
+  unsigned long mExtrapolationCaptureSlot = 0uL;  // Simulation thread only.
+  unsigned long volatile mExtrapolationLatestSlot = 1uL;
+  unsigned long mExtrapolationReadSlot = 2uL;  // Multimedia thread only.
+
+  // mExtrapolation is only written by the multimedia thread, simulation thread requests the clear via this flag.
+  unsigned long volatile mExtrapolationClearRequested = 0uL;
+
+  // Copy of mExtrapolation statistics for StatisticsUpdate, guarded by the sequence number (odd while being written).
+  rF2BufferStatistics mExtrapolationStatistics = {};
+  unsigned long volatile mExtrapolationStatisticsVersion = 0uL;
+
+  double mTimestampTicksPerSecond = 1.0;
+
+  // Last Scoring update as needed by DerivedTimingPublish, which also runs on each completed telemetry frame.
+  struct DerivedTimingTrackSource
+  {
+    double mLapDist;
+    double mSpeed;      // Current speed, advances mLapDist.
+    double mGapSpeed;   // Average lap speed, converts distance to the vehicle ahead into the gap.
+    bool mOnTrack;      // Not in the garage stall, DNF or DQ.
+  };
+
+  rF2VehicleDerivedTiming mDerivedTimingStandings[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];
+  DerivedTimingTrackSource mDerivedTimingTrackSources[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];
+  long mDerivedTimingNumVehicles = 0L;
+  double mDerivedTimingScoringET = -1.0;  // -1 if there's no Scoring update to publish.
+  double mDerivedTimingTrackLength = 0.0;
+
+  // Last seen mHeartbeat of each rF2ReaderRegistry slot, and when it last changed.
+  unsigned long mReaderLastHeartbeats[rF2ReaderRegistry::MAX_READERS];
+  double mReaderLastHeartbeatTicks[rF2ReaderRegistry::MAX_READERS];
+
   MappedBuffer<rF2Telemetry> mTelemetry;
   MappedBuffer<rF2Scoring> mScoring;
   MappedBuffer<rF2Rules> mRules;
@@ -416,12 +706,24 @@ private:
   MappedBuffer<rF2Extended> mExtended;
   MappedBuffer<rF2PitInfo> mPitInfo;
   MappedBuffer<rF2Weather> mWeather;
+  MappedBuffer<rF2TelemetryHistory> mTelemetryHistory;
+  MappedBuffer<rF2TelemetryLite> mTelemetryLite;
+  MappedBuffer<rF2TelemetryProjections> mTelemetryProjections;
+  MappedBuffer<rF2PlayerTelemetry> mPlayerTelemetry;
+  MappedBuffer<rF2Extrapolation> mExtrapolation;
+  MappedBuffer<rF2ReaderRegistry> mReaderRegistry;
+  MappedBuffer<rF2HWControlNames> mHWControlNames;
+  MappedBuffer<rF2Statistics> mStatistics;
+  MappedBuffer<rF2SessionTransition> mSessionTransition;
+  MappedBuffer<rF2EventJournal> mEventJournal;
+  MappedBuffer<rF2DerivedTiming> mDerivedTiming;
 
   // Input buffers:
   MappedBuffer<rF2HWControl> mHWControl;
   MappedBuffer<rF2WeatherControl> mWeatherControl;
   MappedBuffer<rF2RulesControl> mRulesControl;
   MappedBuffer<rF2PluginControl> mPluginControl;
+  MappedBuffer<rF2TelemetryProjectionControl> mTelemetryProjectionControl;
 
   // All buffers mapped successfully or not.
   bool mIsMapped = false;
@@ -33,9 +33,23 @@ namespace rF2SMMonitor
     public const string MM_PITINFO_FILE_NAME = "$rFactor2SMMP_PitInfo$";
     public const string MM_WEATHER_FILE_NAME = "$rFactor2SMMP_Weather$";
     public const string MM_EXTENDED_FILE_NAME = "$rFactor2SMMP_Extended$";
+    public const string MM_TELEMETRY_HISTORY_FILE_NAME = "$rFactor2SMMP_TelemetryHistory$";
+    public const string MM_TELEMETRY_LITE_FILE_NAME = "$rFactor2SMMP_TelemetryLite$";
+    public const string MM_TELEMETRY_PROJECTIONS_FILE_NAME = "$rFactor2SMMP_TelemetryProjections$";
+    public const string MM_PLAYER_TELEMETRY_FILE_NAME = "$rFactor2SMMP_PlayerTelemetry$";
+    public const string MM_EXTRAPOLATION_FILE_NAME = "$rFactor2SMMP_Extrapolation$";
+    public const string MM_READER_REGISTRY_FILE_NAME = "$rFactor2SMMP_ReaderRegistry$";
+    public const string MM_HWCONTROL_NAMES_FILE_NAME = "$rFactor2SMMP_HWControlNames$";
+    public const string MM_STATISTICS_FILE_NAME = "$rFactor2SMMP_Statistics$";
+    public const string MM_SESSION_TRANSITION_FILE_NAME = "$rFactor2SMMP_SessionTransition$";
+    public const string MM_EVENT_JOURNAL_FILE_NAME = "$rFactor2SMMP_EventJournal$";
+    public const string MM_DERIVED_TIMING_FILE_NAME = "$rFactor2SMMP_DerivedTiming$";
 
     public const string MM_HWCONTROL_FILE_NAME = "$rFactor2SMMP_HWControl$";
     public const int MM_HWCONTROL_LAYOUT_VERSION = 1;
+    public const int MM_HWCONTROL_QUEUE_LAYOUT_VERSION = 2;
+    public const int MAX_HWCONTROL_QUEUED_COMMANDS = 64;
+    public const int MAX_HWCONTROLS = 1024;
 
     public const string MM_WEATHER_CONTROL_FILE_NAME = "$rFactor2SMMP_WeatherControl$";
     public const int MM_WEATHER_CONTROL_LAYOUT_VERSION = 1;
@@ -46,10 +60,27 @@ namespace rF2SMMonitor
     public const string MM_PLUGIN_CONTROL_FILE_NAME = "$rFactor2SMMP_PluginControl$";
     public const int MM_PLUGIN_CONTROL_LAYOUT_VERSION = 1;
 
+    public const string MM_TELEMETRY_PROJECTION_CONTROL_FILE_NAME = "$rFactor2SMMP_TelemetryProjectionControl$";
+    public const int MM_TELEMETRY_PROJECTION_CONTROL_LAYOUT_VERSION = 1;
+
     public const int MAX_MAPPED_VEHICLES = 128;
     public const int MAX_MAPPED_IDS = 512;
+    public const int NUM_EXTENDED_SECTIONS = 6;
+    public const int MAX_IMPACTS = 256;
+    public const int VEHICLE_ID_INDEX_SLOTS = 256;
+    public const int MAX_TELEMETRY_HISTORY_FRAMES = 256;
+    public const int MAX_TELEMETRY_HISTORY_VEHICLE_SLOTS = 8192;
+    public const int MAX_TELEMETRY_PROJECTIONS = 4;
+    public const int MAX_STATISTICS_BUFFERS = 16;
+    public const int NUM_STATISTICS_HISTOGRAM_BUCKETS = 24;
+    public const int MAX_EVENTS = 1024;
+    public const int MAX_READERS = 32;
+    public const int READER_HEARTBEAT_TIMEOUT_MS = 2000;
+    public const int SIZEOF_VEHICLE_TELEMETRY = 1888;  // sizeof(rF2VehicleTelemetry) in the plugin.
     public const int MAX_STATUS_MSG_LEN = 128;
     public const int MAX_RULES_INSTRUCTION_MSG_LEN = 96;
+    public const int CACHE_LINE_SIZE = 64;
+    public const int CACHE_LINE_ISOLATED_HEADER_SIZE = 64;  // Offset of the buffer in the cache line isolated layout (see rF2Extended.mCacheLineIsolatedBuffersMask).
     public const int MAX_HWCONTROL_NAME_LEN = 96;
     public const string RFACTOR2_PROCESS_NAME = "rFactor2";
 
@@ -827,6 +858,30 @@ namespace rF2SMMonitor
     }
 
 
+    // Only present in buffers mapped in the triple buffered layout (see rF2Extended.mTripleBufferedBuffersMask).
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2MappedBufferSlotBlock
+    {
+      public const int NUM_SLOTS = 3;
+
+      public uint mPublishedSlot;               // Index of the slot holding the last completed frame.
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rF2MappedBufferSlotBlock.NUM_SLOTS)]
+      public uint[] mSlotVersions;              // mVersionUpdateBegin of the frame held by each slot, 0 while slot is being written to.
+    }
+
+
+    // mID to mVehicles index map.  Lookup: start at slot (mID % VEHICLE_ID_INDEX_SLOTS), and continue to the next slot
+    // (wrapping around) until mID is found, or -1 is hit (mID is not in the update).
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2VehicleIDIndex
+    {
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.VEHICLE_ID_INDEX_SLOTS)]
+      public int[] mIDs;                        // mID held in the slot, -1 if the slot is empty.
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.VEHICLE_ID_INDEX_SLOTS)]
+      public byte[] mVehicleIndices;            // mVehicles index of mIDs[slot].
+    }
+
+
     [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
     public struct rF2Telemetry
     {
@@ -839,6 +894,199 @@ namespace rF2SMMonitor
       public int mNumVehicles;                  // current number of vehicles
       [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
       public rF2VehicleTelemetry[] mVehicles;
+
+      // Bit (i % 8) of byte (i / 8) is set if mVehicles[i] changed since the previous update.
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES / 8)]
+      public byte[] mVehicleChangedBits;
+      // mID to mVehicles index map of this update.
+      public rF2VehicleIDIndex mVehicleIDIndex;
+    }
+
+
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2TelemetryHistoryFrame
+    {
+      public uint mSequence;                    // Sequence number of the frame held in this slot.  0 while slot is empty or being written to.
+      public double mElapsedTime;               // Game ET of the frame (min mElapsedTime of vehicles in the frame).
+      public int mNumVehicles;                  // Number of vehicles in the frame.
+      public uint mFirstVehicle;                // Running index of the frame's first vehicle in the vehicle pool.  Vehicle i of the frame is at
+                                                // mVehicles[(mFirstVehicle + i) % MAX_TELEMETRY_HISTORY_VEHICLE_SLOTS].
+    }
+
+
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2TelemetryHistory
+    {
+      public uint mVersionUpdateBegin;          // Incremented right before buffer is written to.
+      public uint mVersionUpdateEnd;            // Incremented after buffer write is done.
+
+      public uint mLastSequence;                // Sequence number of the last completed frame, starts at 1.  0 means no frames captured.
+      public uint mVehiclesWritten;             // Running count of vehicles written into the pool, including the frame currently being written.
+      public uint mReadableFrames;              // Number of the last frames (up to mLastSequence) whose vehicles are not overwritten.
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_TELEMETRY_HISTORY_FRAMES)]
+      public rF2TelemetryHistoryFrame[] mFrames;
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_TELEMETRY_HISTORY_VEHICLE_SLOTS)]
+      public rF2VehicleTelemetry[] mVehicles;
+    }
+
+
+    // Struct-of-arrays layout: value for vehicle i (same order as rF2Telemetry.mVehicles) is at mField[i].
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2TelemetryLite
+    {
+      public uint mVersionUpdateBegin;          // Incremented right before buffer is written to.
+      public uint mVersionUpdateEnd;            // Incremented after buffer write is done.
+
+      public double mElapsedTime;               // Game ET of the frame (min mElapsedTime of vehicles in the frame).
+      public int mNumVehicles;                  // Number of valid entries in each array.
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.CACHE_LINE_SIZE - 12)]
+      public byte[] mExpansion;                 // Pads the header to the cache line.
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public int[] mID;                                   // slot ID
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public int[] mLapNumber;                            // current lap number
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public int[] mCurrentSector;                        // zero-based sector, with pitlane stored in the sign bit
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public double[] mLapStartET;                      // time this lap was started
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public float[] mPosX;                              // world position in meters
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public float[] mPosY;
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public float[] mPosZ;
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public float[] mSpeed;                             // magnitude of mLocalVel (meters/sec)
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public float[] mEngineRPM;                         // engine RPM
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public float[] mEngineMaxRPM;                      // rev limit
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public float[] mFilteredThrottle;                  // ranges  0.0-1.0
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public float[] mFilteredBrake;                     // ranges  0.0-1.0
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public float[] mFilteredClutch;                    // ranges  0.0-1.0
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public float[] mFilteredSteering;                  // ranges -1.0-1.0 (left to right)
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public float[] mFuel;                              // amount of fuel (liters)
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public float[] mFuelCapacity;                      // capacity in liters
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public sbyte[] mGear;                              // -1=reverse, 0=neutral, 1+=forward gears
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public byte[] mMaxGears;                           // maximum forward gears
+    }
+
+
+    // Flags selecting contiguous ranges of rF2VehicleTelemetry fields.
+    public enum rF2TelemetryFieldGroup
+    {
+      Time = 1,                      // mID ... mLapStartET
+      Names = 2,                     // mVehicleName, mTrackName
+      Position = 4,                  // mPos, mLocalVel, mLocalAccel
+      Orientation = 8,               // mOri, mLocalRot, mLocalRotAccel
+      VehicleStatus = 16,            // mGear ... mClutchRPM
+      UnfilteredInput = 32,          // mUnfilteredThrottle ... mUnfilteredClutch
+      FilteredInput = 64,            // mFilteredThrottle ... mFilteredClutch
+      Misc = 128,                    // mSteeringShaftTorque ... mRear3rdDeflection
+      Aerodynamics = 256,            // mFrontWingHeight ... mRearDownforce
+      StateDamage = 512,             // mFuel ... mLastImpactPos
+      Expanded = 1024,               // mEngineTorque ... mElectricBoostMotorState
+      Wheels = 2048,                 // mWheels
+      All = 4095
+    }
+
+
+    // Flags selecting contiguous ranges of rF2Extended fields, see rF2Extended.mSectionVersions.
+    public enum rF2ExtendedSection
+    {
+      Physics = 1,                   // mVersion ... mPhysics
+      Damage = 2,                    // mTrackedDamages
+      CallbackFlags = 4,             // mInRealtimeFC ... mTicksSessionEnded
+      SessionCapture = 8,            // mSessionTransitionCapture
+      PluginState = 16,              // mDisplayedMessageUpdateCapture ... mEventDrivenInputBuffers (messages, DMA and plugin state)
+      Impacts = 32,                  // mLastImpactSequence ... mImpacts
+      All = 63
+    }
+
+
+    // Record of vehicle i starts at mRecords[i * mRecordSize] and consists of the requested field groups, packed in the flag order.
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2TelemetryProjection
+    {
+      public uint mFieldGroupsMask;             // rF2TelemetryFieldGroup flags of this projection.  0 means projection is not active.
+      public int mRecordSize;                   // Size of the single vehicle record in bytes.
+      public int mNumVehicles;                  // Number of vehicle records.
+      public double mElapsedTime;               // Game ET of the frame.
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES * rFactor2Constants.SIZEOF_VEHICLE_TELEMETRY)]
+      public byte[] mRecords;
+    }
+
+
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2TelemetryProjections
+    {
+      public uint mVersionUpdateBegin;          // Incremented right before buffer is written to.
+      public uint mVersionUpdateEnd;            // Incremented after buffer write is done.
+
+      public int mBytesUpdatedHint;             // How many bytes of the structure were written during the last update.
+                                                // 0 means unknown (whole buffer should be considered as updated).
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_TELEMETRY_PROJECTIONS)]
+      public rF2TelemetryProjection[] mProjections;
+    }
+
+
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2PlayerTelemetry
+    {
+      public uint mVersionUpdateBegin;          // Incremented right before buffer is written to.
+      public uint mVersionUpdateEnd;            // Incremented after buffer write is done.
+
+      public Int64 mTimestamp;                  // When the update was received.  Same time base as rF2MappedBufferPublishStamp.mTimestamp.
+      public rF2VehicleTelemetry mVehicle;      // Player vehicle telemetry.
+    }
+
+
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2VehicleExtrapolation
+    {
+      public int mID;                           // slot ID
+      public double mExtrapolationTime;         // Seconds extrapolated past the vehicle's last telemetry update.
+      public rF2Vec3 mPos;                      // predicted world position in meters
+      public rF2Vec3 mWorldVel;                 // predicted velocity (meters/sec) in world coordinates
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = 3)]
+      public rF2Vec3[] mOri;                    // predicted rows of orientation matrix (same convention as rF2VehicleTelemetry.mOri)
+    }
+
+
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2Extrapolation
+    {
+      public uint mVersionUpdateBegin;          // Incremented right before buffer is written to.
+      public uint mVersionUpdateEnd;            // Incremented after buffer write is done.
+
+      public int mBytesUpdatedHint;             // How many bytes of the structure were written during the last update.
+                                                // 0 means unknown (whole buffer should be considered as updated).
+
+      public Int64 mTimestamp;                  // Prediction time.  QueryPerformanceCounter value when the prediction was made.
+      public double mElapsedTime;               // Game ET the prediction is for.
+      public double mSourceElapsedTime;         // Game ET of the telemetry frame extrapolated from.
+      public int mNumVehicles;                  // Number of valid entries in mVehicles.
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public rF2VehicleExtrapolation[] mVehicles;
     }
 
 
@@ -855,6 +1103,16 @@ namespace rF2SMMonitor
 
       [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
       public rF2VehicleScoring[] mVehicles;
+
+      // Bit (i % 8) of byte (i / 8) is set if mVehicles[i] changed since the previous update.
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES / 8)]
+      public byte[] mVehicleChangedBits;
+      // mID to mVehicles index map of this update.
+      public rF2VehicleIDIndex mVehicleIDIndex;
+
+      // mVehicles indices sorted by mPlace (first mScoringInfo.mNumVehicles are valid).
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public byte[] mPlaceOrder;
     }
 
 
@@ -961,6 +1219,20 @@ namespace rF2SMMonitor
     };
 
 
+    [StructLayout(LayoutKind.Sequential, Pack = 4)]
+    public struct rF2ImpactRecord
+    {
+      public uint mSequence;                    // Sequence number of the impact held in this slot.  0 if slot is empty.
+      public int mID;                           // slot ID of the vehicle
+      public double mLastImpactET;              // time of impact
+      public double mLastImpactMagnitude;       // magnitude of impact
+      public rF2Vec3 mLastImpactPos;            // location of impact
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = 8)]
+      public byte[] mDentSeverity;              // dent severity at 8 locations around the car, as of the telemetry update impact was seen in (0=none, 1=some, 2=more)
+    };
+
+
     [StructLayout(LayoutKind.Sequential, Pack = 4)]
     public struct rF2VehScoringCapture
     {
@@ -1055,6 +1327,211 @@ namespace rF2SMMonitor
       public byte mWeatherControlInputEnabled;                  // WeatherControl input buffer is enabled.
       public byte mRulesControlInputEnabled;                    // RulesControl input buffer is enabled.
       public byte mPluginControlInputEnabled;                   // Plugin control input buffer is enabled.
+
+      public int mTripleBufferedBuffersMask;                   // Currently active TripleBufferedBuffersMask value.  Buffers in this mask are mapped in the triple buffered layout (see rF2MappedBufferSlotBlock).
+      public int mUpdateNotificationBuffersMask;               // Currently active UpdateNotificationBuffersMask value.  Buffers in this mask signal each completed update.
+      public int mCacheLineIsolatedBuffersMask;                // Currently active CacheLineIsolatedBuffersMask value.  Buffers in this mask are mapped in the cache line isolated layout.
+      public int mLargePagesBuffersMask;                       // Buffers actually backed by large pages.  Subset of LargePagesBuffersMask value, large pages might not be available.
+      public int mSuspendIdleBuffersMask;                      // Currently active SuspendIdleBuffersMask value.  Buffers in this mask are not updated while no client reads them.
+      public int mSuspendedBuffersMask;                        // Buffers currently not updated because no live client registered for them.
+
+      public byte mEventDrivenInputBuffers;                     // Input buffers are also checked in the callbacks applying them, so publish is picked up on the next callback.
+
+      // Incremented each time section is published, indexed by rF2ExtendedSection flag bit.
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.NUM_EXTENDED_SECTIONS)]
+      public uint[] mSectionVersions;
+
+      // Ring of the last impacts, impact with sequence number N is at mImpacts[N % MAX_IMPACTS].
+      public uint mLastImpactSequence;          // Sequence number of the last impact, starts at 1.  0 means no impacts recorded.
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_IMPACTS)]
+      public rF2ImpactRecord[] mImpacts;
+    }
+
+
+    // Follows the last slot of every output buffer.
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2MappedBufferPublishStamp
+    {
+      public uint mVersion;                     // mVersionUpdateBegin of the update stamped.
+      public Int64 mTimestamp;                  // When update was published.  QueryPerformanceCounter value.
+      public double mElapsedTime;               // Game ET of the published data, -1.0 if it does not apply to the buffer.
+    }
+
+
+    // Histograms are in log2 buckets of microseconds: bucket 0 counts values below 1us, bucket i counts values in [2^(i-1), 2^i) us.
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2BufferStatistics
+    {
+      public uint mNumUpdates;                  // Updates published since plugin startup.
+      public Int64 mLastPublishTimestamp;       // rF2MappedBufferPublishStamp.mTimestamp of the last update.
+      public double mLastPublishElapsedTime;    // rF2MappedBufferPublishStamp.mElapsedTime of the last update.
+      public double mMaxUpdateMicroseconds;     // Max time plugin spent writing an update.
+      public double mMaxIntervalMicroseconds;   // Max time between two publishes.
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.NUM_STATISTICS_HISTOGRAM_BUCKETS)]
+      public uint[] mUpdateHistogram;           // Time plugin spent writing an update.
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.NUM_STATISTICS_HISTOGRAM_BUCKETS)]
+      public uint[] mIntervalHistogram;         // Time between two publishes.
+    }
+
+
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2Statistics
+    {
+      public uint mVersionUpdateBegin;          // Incremented right before buffer is written to.
+      public uint mVersionUpdateEnd;            // Incremented after buffer write is done.
+
+      public Int64 mTimestampFrequency;         // Timestamp ticks per second.
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_STATISTICS_BUFFERS)]
+      public rF2BufferStatistics[] mBuffers;    // Indexed by SubscribedBuffer flag bit.
+    }
+
+
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2SessionTransitionFrame
+    {
+      public uint mSequence;                    // Sequence number of the capture (shared by both frames of rF2SessionTransition).  0 if nothing captured yet.
+      public Int64 mTicksCaptured;              // Ticks when captured, same as rF2Extended.mTicksSessionStarted/mTicksSessionEnded.
+
+      public rF2ScoringInfo mScoringInfo;       // Last Scoring update before the transition.
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public rF2VehicleScoring[] mScoringVehicles;
+
+      public rF2TrackRules mTrackRules;         // Last Rules update before the transition.
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public rF2TrackRulesAction[] mRulesActions;
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public rF2TrackRulesParticipant[] mRulesParticipants;
+    }
+
+
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2SessionTransition
+    {
+      public uint mVersionUpdateBegin;          // Incremented right before buffer is written to.
+      public uint mVersionUpdateEnd;            // Incremented after buffer write is done.
+
+      public uint mLastSequence;                          // Sequence number of the last capture.
+      public rF2SessionTransitionFrame mSessionEnd;       // Captured on the last EndSession call.
+      public rF2SessionTransitionFrame mSessionStart;     // Captured on the last StartSession call.
+    }
+
+
+    // State transitions detected by comparing consecutive Scoring updates.  mOldValue/mNewValue hold the compared member values.
+    public enum rF2EventType
+    {
+      PitEntered = 1,                // mInPits became true
+      PitExited = 2,                 // mInPits became false
+      PitStateChanged = 3,           // mPitState
+      FlagChanged = 4,               // mFlag (vehicle)
+      LapCompleted = 5,              // mTotalLaps increased
+      PenaltiesChanged = 6,          // mNumPenalties
+      FinishStatusChanged = 7,       // mFinishStatus
+      GamePhaseChanged = 8,          // mGamePhase (session)
+      SessionChanged = 9,            // mSession (session)
+      YellowFlagStateChanged = 10,   // mYellowFlagState (session)
+      SectorFlagChanged = 11         // mSectorFlag[mIndex] (session)
+    }
+
+
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2Event
+    {
+      public uint mSequence;                    // Sequence number of the event held in this slot.  0 while slot is empty or being written to.
+      public int mType;                         // rF2EventType
+      public double mElapsedTime;               // mCurrentET of the Scoring update transition was detected in.
+      public int mID;                           // Vehicle mID, -1 for session events.
+      public int mIndex;                        // mVehicles index of the vehicle in that Scoring update, or sector index for SectorFlagChanged, -1 otherwise.
+      public int mOldValue;
+      public int mNewValue;
+    }
+
+
+    // See rF2EventJournal in rF2State.h for the read protocol.
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2EventJournal
+    {
+      public uint mVersionUpdateBegin;          // Incremented right before buffer is written to.
+      public uint mVersionUpdateEnd;            // Incremented after buffer write is done.
+
+      public uint mLastSequence;                // Sequence number of the last event, starts at 1.  0 means no events recorded.
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_EVENTS)]
+      public rF2Event[] mEvents;
+    }
+
+
+    // Gaps are split into seconds and full laps, same as mTimeBehindLeader/mLapsBehindLeader.  IDs are -1 where there's no such vehicle.
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2VehicleDerivedTiming
+    {
+      public int mID;                           // slot ID
+      public byte mPlace;                       // 1-based position
+      public byte mClassPlace;                  // 1-based position within mVehicleClass
+
+      public double mTimeBehindLeader;          // same as rF2VehicleScoring.mTimeBehindLeader
+      public int mLapsBehindLeader;
+      public double mTimeBehindNext;            // interval to the vehicle in next higher place, same as rF2VehicleScoring.mTimeBehindNext
+      public int mLapsBehindNext;
+
+      public int mClassLeaderID;                // leader of mVehicleClass
+      public double mTimeBehindClassLeader;
+      public int mLapsBehindClassLeader;
+      public int mClassNextID;                  // vehicle in next higher place within mVehicleClass
+      public double mTimeBehindClassNext;
+      public int mLapsBehindClassNext;
+
+      // Relative on-track gaps, regardless of place.  Vehicles in the garage stall or retired are not considered.
+      public double mLapDist;                   // mLapDist interpolated to rF2DerivedTiming.mElapsedTime
+      public int mTrackAheadID;                 // nearest vehicle ahead on track
+      public double mTrackGapAhead;             // seconds this vehicle needs to reach mTrackAheadID's position, -1.0 if unknown
+      public int mTrackBehindID;                // nearest vehicle behind on track
+      public double mTrackGapBehind;            // seconds mTrackBehindID needs to reach this vehicle's position, -1.0 if unknown
+    }
+
+
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2DerivedTiming
+    {
+      public uint mVersionUpdateBegin;          // Incremented right before buffer is written to.
+      public uint mVersionUpdateEnd;            // Incremented after buffer write is done.
+
+      public int mBytesUpdatedHint;             // How many bytes of the structure were written during the last update.
+                                                // 0 means unknown (whole buffer should be considered as updated).
+
+      public double mScoringElapsedTime;        // mCurrentET of the Scoring update gaps are derived from.
+      public double mElapsedTime;               // Game ET on-track positions are interpolated to (telemetry frame ET, or mScoringElapsedTime).
+      public int mNumVehicles;                  // Number of valid entries in mVehicles.
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_MAPPED_VEHICLES)]
+      public rF2VehicleDerivedTiming[] mVehicles;
+    }
+
+
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2ReaderSlot
+    {
+      public uint mProcessId;                   // Process ID of the client owning this slot.  0 means slot is free.
+      public int mBuffersMask;                  // SubscribedBuffer flags of the buffers client reads.
+      public uint mHeartbeat;                   // Incremented by the client while it is alive.
+    }
+
+
+    // Written by the clients, see rF2ReaderRegistry in rF2State.h for the protocol.
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2ReaderRegistry
+    {
+      public uint mVersionUpdateBegin;          // Not used.
+      public uint mVersionUpdateEnd;            // Not used.
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_READERS)]
+      public rF2ReaderSlot[] mReaders;
     }
 
 
@@ -1069,6 +1546,32 @@ namespace rF2SMMonitor
       [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_HWCONTROL_NAME_LEN)]
       public byte[] mControlName;
       public double mfRetVal;
+
+      // Layout version 2 queue (mQueueWriteIndex, mQueueReadIndex, rF2HWControlCommand[MAX_HWCONTROL_QUEUED_COMMANDS]) follows,
+      // and is not mirrored here, so that writing this struct does not reset the queue indices.
+    }
+
+
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2HWControlCommand
+    {
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_HWCONTROL_NAME_LEN)]
+      public byte[] mControlName;
+      public double mfRetVal;
+    }
+
+
+    // Names of the controls rF2HWControl accepts.  Name i is at mControlNames[i * MAX_HWCONTROL_NAME_LEN].
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    public struct rF2HWControlNames
+    {
+      public uint mVersionUpdateBegin;          // Incremented right before buffer is written to.
+      public uint mVersionUpdateEnd;            // Incremented after buffer write is done.
+
+      public int mNumControls;
+
+      [MarshalAsAttribute(UnmanagedType.ByValArray, SizeConst = rFactor2Constants.MAX_HWCONTROLS * rFactor2Constants.MAX_HWCONTROL_NAME_LEN)]
+      public byte[] mControlNames;
     }
 
 
@@ -1117,6 +1620,19 @@ namespace rF2SMMonitor
     }
 
 
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 4)]
+    struct rF2TelemetryProjectionControl
+    {
+      public uint mVersionUpdateBegin;          // Incremented right before buffer is written to.
+      public uint mVersionUpdateEnd;            // Incremented after buffer write is done.
+
+      public int mLayoutVersion;
+
+      public int mProjectionIndex;              // [0, MAX_TELEMETRY_PROJECTIONS)
+      public uint mFieldGroupsMask;             // rF2TelemetryFieldGroup flags.
+    }
+
+
     enum SubscribedBuffer
     {
       Telemetry = 1,
@@ -1127,7 +1643,14 @@ namespace rF2SMMonitor
       Graphics = 32,
       PitInfo = 64,
       Weather = 128,
-      All = 255
+      TelemetryHistory = 256,
+      TelemetryLite = 512,
+      TelemetryProjections = 1024,
+      PlayerTelemetry = 2048,
+      Extrapolation = 4096,
+      EventJournal = 8192,
+      DerivedTiming = 16384,
+      All = 32767
     };
   }
 }
\ No newline at end of file
@@ -32,12 +32,24 @@ Shared resources:
     * PitInfo - mapped view of rF2PitInfo structure
     * Weather - mapped view of rF2Weather structure
     * Extended - mapped view of rF2Extended structure
+    * TelemetryHistory - mapped view of rF2TelemetryHistory structure
+    * TelemetryLite - mapped view of rF2TelemetryLite structure
+    * TelemetryProjections - mapped view of rF2TelemetryProjections structure
+    * PlayerTelemetry - mapped view of rF2PlayerTelemetry structure
+    * Extrapolation - mapped view of rF2Extrapolation structure
+    * ReaderRegistry - mapped view of rF2ReaderRegistry structure (written by the clients)
+    * HWControlNames - mapped view of rF2HWControlNames structure
+    * Statistics - mapped view of rF2Statistics structure
+    * SessionTransition - mapped view of rF2SessionTransition structure
+    * EventJournal - mapped view of rF2EventJournal structure
+    * DerivedTiming - mapped view of rF2DerivedTiming structure
 
   Input buffers:
     * HWControl - mapped view of rF2HWControl structure
     * WeatherControl - mapped view of rF2WeatherControl structure
     * RulesControl - mapped view of rF2RulesControl structure
     * PluginControl - mapped view of rF2PluginControl structure
+    * TelemetryProjectionControl - mapped view of rF2TelemetryProjectionControl structure
 
   Aside from Extended (see below), output buffers are (with few exceptions) exact mirror of ISI structures, plugin constantly memcpy's them
   from game to memory mapped files.
@@ -57,6 +69,16 @@ Output buffer refresh rates:
   PitInfo - 100FPS.
   Weather - 1FPS.
   Extended - every 200ms (5FPS) or on tracked function call.
+  TelemetryHistory - on each completed Telemetry frame (50FPS).
+  TelemetryLite - on each completed Telemetry frame (50FPS).
+  TelemetryProjections - on each completed Telemetry frame (50FPS).
+  PlayerTelemetry - on each player vehicle telemetry update game sends (100FPS).
+  Extrapolation - on each graphics update (approximately 400FPS).
+  HWControlNames - when new control names are learned, normally during the first frames only.
+  Statistics - 5FPS.
+  SessionTransition - on session start and end.
+  EventJournal - on Scoring updates that detected state transitions (up to 5FPS).
+  DerivedTiming - on each Scoring update (5FPS) and on each completed Telemetry frame (50FPS).
 
   The Plugin does not add artificial delays, except:
     - game calls UpdateTelemetry in bursts every 10ms.  However, as of 02/18 data changes only every 20ms, so one of those bursts is dropped.
@@ -65,18 +87,77 @@ Output buffer refresh rates:
   The Plugin supports unsubscribing from buffer updates via UnsubscribedBuffersMask CustomPluginVariables.json flag.  Clients can also subscribe
   to the currently unsubscribed buffers via rF2PluginControl input buffer.
 
+  Buffers in the SuspendIdleBuffersMask CustomPluginVariables.json flag are only updated while at least one client registered in the
+  ReaderRegistry buffer reads them and keeps its heartbeat going.  Registry is checked at 5FPS, so suspended buffer resumes within 200ms.
+
 Input buffer refresh rates:
 
   HWControl - Read at 5FPS with 500ms boost to 50FPS once update is received.  Applied at 100FPS.
+              Layout version 2 command queue is checked every frame, and queued commands are applied in order.
   WeatherControl - Read at 5FPS.  Applied at 1FPS.
   RulesControl - Read at 5FPS.  Applied at 3FPS.
   PluginControl - Read at 5FPS.  Applied on read.
+  TelemetryProjectionControl - Read at 5FPS.  Applied on the next completed Telemetry frame.
+
+  With EventDrivenInputBuffers CustomPluginVariables.json flag on, input buffer version blocks are also checked in the callbacks
+  that apply them: HWControl in HasHardwareInputs (100FPS), WeatherControl in AccessWeather, RulesControl in AccessTrackRules,
+  PluginControl and TelemetryProjectionControl on each completed Telemetry frame.  Check is a version block compare, so client
+  publish is picked up on the next callback without any client changes.
 
 
 Telemetry state:
   rF2 calls UpdateTelemetry for each vehicle.  The Plugin tries to guess when all vehicles have received an update, and only after
   that the buffer write is marked as complete.
 
+  Each completed frame is also appended to the TelemetryHistory buffer, which keeps up to rF2TelemetryHistory::MAX_FRAMES last frames
+  and rF2TelemetryHistory::MAX_VEHICLE_SLOTS last vehicle updates (so, in a big field, vehicle pool limits the depth, which is
+  published in mReadableFrames).  This allows clients (data loggers, analysis tools) to read
+  in batches at their own pace without missing frames.  Frames are numbered with the increasing sequence number and tagged with
+  the game ET.  See rF2TelemetryHistory for the read protocol.  TelemetryHistory is unsubscribed from by default.
+
+  Each completed frame is also published to the TelemetryLite buffer, which holds the few values most of the HUDs and dashes need
+  in the struct-of-arrays layout (see rF2TelemetryLite).  It is about 25 times smaller than rF2Telemetry, so clients that only need
+  those values copy much less.  TelemetryLite is unsubscribed from by default.
+
+  Clients that need a different subset of rF2VehicleTelemetry can request it via rF2TelemetryProjectionControl input buffer, as a mask
+  of rF2TelemetryFieldGroup flags.  Each completed frame is then also published, packed down to the requested field groups, into the
+  corresponding slot of the TelemetryProjections buffer.  Up to rF2TelemetryProjections::MAX_PROJECTIONS projections can be active at
+  the same time.  TelemetryProjections is unsubscribed from by default.
+
+  Player vehicle telemetry is also published to the PlayerTelemetry buffer, on every UpdateTelemetry call for it, before frame
+  assembly and without dropping the duplicate updates.  This gives motion rigs and haptics the full rate game provides.  Player
+  vehicle is detected via mIsPlayer in Scoring updates.  PlayerTelemetry is unsubscribed from by default.
+
+  Renderers running at higher rate than telemetry can read the Extrapolation buffer instead of extrapolating themselves.  Motion
+  state of each vehicle is captured from each completed telemetry frame, and on each UpdateGraphics call it is dead reckoned
+  (second order in position, constant angular velocity in orientation) to the current time.  Extrapolation is capped at
+  MAX_EXTRAPOLATION_SECONDS past the vehicle update.  Extrapolation is unsubscribed from by default.  UpdateGraphics is called on
+  the multimedia thread, while telemetry is captured on the simulation thread.  Captured frames are handed over via a triple
+  buffer, and the Extrapolation buffer, including its clearing on session change, is only written by the multimedia thread.
+
+  Telemetry and Scoring buffers expose mVehicleChangedBits, which allows readers that did not miss an update to copy only
+  vehicles that changed since the previous update.
+
+  Telemetry and Scoring buffers also expose mVehicleIDIndex, mID to mVehicles index map of the same update (see rF2VehicleIDIndex),
+  so that clients can join the two without scanning for the matching mID.  Scoring also exposes mPlaceOrder, mVehicles indices
+  sorted by place.
+
+  State transitions (pit entry/exit, flags, completed laps, penalties, finish status, session phase) are detected once per Scoring
+  update, by comparing vehicles with the previous update via its mVehicleIDIndex, and appended to the EventJournal ring.  Clients
+  can tail it instead of diffing Scoring updates themselves.  EventJournal is unsubscribed from by default.
+
+  Gaps and intervals (overall, within mVehicleClass, and to the nearest vehicles on track) are published into the DerivedTiming
+  buffer, so that timing overlays do not have to re-derive them.  Standings are computed once per Scoring update.  On-track
+  positions, neighbours and gaps are refreshed on each completed telemetry frame as well: Scoring positions are advanced to
+  the telemetry frame ET (up to MAX_TIMING_INTERPOLATION_SECONDS past the Scoring update).  DerivedTiming is unsubscribed from
+  by default.
+
+
+Publish timing:
+  Each output buffer mapping ends with rF2MappedBufferPublishStamp, which tells when the last update was published (QPC timestamp)
+  and the game ET of the data, where it applies.  Update duration and inter-publish interval histograms of each buffer are published
+  to the Statistics buffer at 5FPS (see rF2Statistics), so that plugin induced latency can be monitored without the debug output.
+
 
 Extended state:
   Exposed extended state consists of:
@@ -111,6 +192,29 @@ Output buffer synchronization:
   Note: $rFactor2SMMP_ForceFeedback$ buffer consists of a single double variable.  Since write into double is atomic, a version block
   is not used (I assume compiler aligned double member correctly for x64, and I am too lazy atm to check).
 
+  Optionally, buffers listed in TripleBufferedBuffersMask CustomPluginVariables.json value are mapped in the triple buffered
+  layout: rF2MappedBufferVersionBlock is followed by rF2MappedBufferSlotBlock and rF2MappedBufferSlotBlock::NUM_SLOTS copies of
+  the buffer.  The Plugin never writes into the published slot, so reading rF2MappedBufferSlotBlock::mPublishedSlot and copying that
+  slot gives complete frame without retrying.  Reader that takes longer than NUM_SLOTS - 1 updates to copy can detect being lapped
+  by checking that rF2MappedBufferSlotBlock::mSlotVersions value of the slot is non-zero and did not change during the copy.
+  Active mask is exposed via rF2Extended::mTripleBufferedBuffersMask.  Extended buffer always uses the regular layout.
+
+  Buffers listed in UpdateNotificationBuffersMask CustomPluginVariables.json value signal each completed update, so that
+  clients can block waiting for the new frame instead of polling.  On Windows, this is a pair of named manual-reset events
+  per buffer (<buffer name>_Update0 and <buffer name>_Update1), see MappedBufferPlatform.h for the wait protocol.
+  Active mask is exposed via rF2Extended::mUpdateNotificationBuffersMask.
+
+  Buffers listed in CacheLineIsolatedBuffersMask CustomPluginVariables.json value are mapped with the header padded to
+  rF2MappedBufferLayout::HEADER_SIZE bytes (and triple buffered slots padded to the cache line size), so that the buffer
+  starts at offset HEADER_SIZE instead of right after the version block.  This keeps the Plugin writes away from the cache
+  line readers poll, which matters once there are several clients spinning on the version block.  Active mask is exposed
+  via rF2Extended::mCacheLineIsolatedBuffersMask.  Extended buffer always uses the regular layout.
+
+  Buffers listed in LargePagesBuffersMask CustomPluginVariables.json value are backed by large pages, if those are available
+  (see MappedBufferPlatform.h), otherwise the Plugin falls back to the regular pages.  This is meant for the big buffers
+  (Telemetry, Rules) and cuts TLB misses on the simulation thread and in the clients.  Layout does not change.  Buffers that
+  actually got large pages are exposed via rF2Extended::mLargePagesBuffersMask.
+
   Most clients (HUDs, Dashes, visualizers) won't need synchronization.  There are many ways on detecting torn frames,
   Monitor app contains sample approach used in the Crew Chief app.
   * For basic reading from C#, see: rF2SMMonitor.MappedBuffer<>.GetMappedDataUnsynchronized.
@@ -137,7 +241,7 @@ Configuration:
 
 Limitations/Assumptions:
   - Negative mID is not supported.
-  - Distance between max(mID) and min(mID) in a session cannot exceed rF2MappedBufferHeader::MAX_MAPPED_IDS.
+  - Max mIDs seen within a minute: rF2Extended::MAX_MAPPED_IDS (see MappedIDTable).
   - Max mapped vehicles: rF2MappedBufferHeader::MAX_MAPPED_VEHICLES.
   - The Plugin assumes that delta Elapsed Time in a telemetry update frame cannot exceed 20ms (which effectively limits telemetry refresh rate to 50FPS).
 
@@ -148,6 +252,7 @@ Sample consumption:
 #include "rFactor2SharedMemoryMap.hpp"          // corresponding header file
 #include <stdlib.h>
 #include <cstddef>                              // offsetof
+#include <ctype.h>                              // tolower
 
 long SharedMemoryPlugin::msDebugOutputLevel = static_cast<long>(DebugLevel::Off);
 static_assert(sizeof(long) <= sizeof(DebugLevel), "sizeof(long) <= sizeof(DebugLevel)");
@@ -162,6 +267,13 @@ bool SharedMemoryPlugin::msDirectMemoryAccessRequested = false;
 long SharedMemoryPlugin::msUnsubscribedBuffersMask = 0L;
 static_assert(sizeof(long) <= sizeof(SubscribedBuffer), "sizeof(long) <= sizeof(SubscribedBuffer)");
 
+long SharedMemoryPlugin::msTripleBufferedBuffersMask = 0L;
+long SharedMemoryPlugin::msUpdateNotificationBuffersMask = 0L;
+long SharedMemoryPlugin::msCacheLineIsolatedBuffersMask = 0L;
+long SharedMemoryPlugin::msLargePagesBuffersMask = 0L;
+long SharedMemoryPlugin::msSuspendIdleBuffersMask = 0L;
+bool SharedMemoryPlugin::msEventDrivenInputBuffers = false;
+
 bool SharedMemoryPlugin::msHWControlInputRequested = false;
 bool SharedMemoryPlugin::msWeatherControlInputRequested = false;
 bool SharedMemoryPlugin::msRulesControlInputRequested = false;
@@ -179,11 +291,23 @@ char const* const SharedMemoryPlugin::MM_GRAPHICS_FILE_NAME = "$rFactor2SMMP_Gra
 char const* const SharedMemoryPlugin::MM_EXTENDED_FILE_NAME = "$rFactor2SMMP_Extended$";
 char const* const SharedMemoryPlugin::MM_PIT_INFO_FILE_NAME = "$rFactor2SMMP_PitInfo$";
 char const* const SharedMemoryPlugin::MM_WEATHER_FILE_NAME = "$rFactor2SMMP_Weather$";
+char const* const SharedMemoryPlugin::MM_TELEMETRY_HISTORY_FILE_NAME = "$rFactor2SMMP_TelemetryHistory$";
+char const* const SharedMemoryPlugin::MM_TELEMETRY_LITE_FILE_NAME = "$rFactor2SMMP_TelemetryLite$";
+char const* const SharedMemoryPlugin::MM_TELEMETRY_PROJECTIONS_FILE_NAME = "$rFactor2SMMP_TelemetryProjections$";
+char const* const SharedMemoryPlugin::MM_PLAYER_TELEMETRY_FILE_NAME = "$rFactor2SMMP_PlayerTelemetry$";
+char const* const SharedMemoryPlugin::MM_EXTRAPOLATION_FILE_NAME = "$rFactor2SMMP_Extrapolation$";
+char const* const SharedMemoryPlugin::MM_READER_REGISTRY_FILE_NAME = "$rFactor2SMMP_ReaderRegistry$";
+char const* const SharedMemoryPlugin::MM_HWCONTROL_NAMES_FILE_NAME = "$rFactor2SMMP_HWControlNames$";
+char const* const SharedMemoryPlugin::MM_STATISTICS_FILE_NAME = "$rFactor2SMMP_Statistics$";
+char const* const SharedMemoryPlugin::MM_SESSION_TRANSITION_FILE_NAME = "$rFactor2SMMP_SessionTransition$";
+char const* const SharedMemoryPlugin::MM_EVENT_JOURNAL_FILE_NAME = "$rFactor2SMMP_EventJournal$";
+char const* const SharedMemoryPlugin::MM_DERIVED_TIMING_FILE_NAME = "$rFactor2SMMP_DerivedTiming$";
 
 char const* const SharedMemoryPlugin::MM_HWCONTROL_FILE_NAME = "$rFactor2SMMP_HWControl$";
 char const* const SharedMemoryPlugin::MM_WEATHER_CONTROL_FILE_NAME = "$rFactor2SMMP_WeatherControl$";
 char const* const SharedMemoryPlugin::MM_RULES_CONTROL_FILE_NAME = "$rFactor2SMMP_RulesControl$";
 char const* const SharedMemoryPlugin::MM_PLUGIN_CONTROL_FILE_NAME = "$rFactor2SMMP_PluginControl$";
+char const* const SharedMemoryPlugin::MM_TELEMETRY_PROJECTION_CONTROL_FILE_NAME = "$rFactor2SMMP_TelemetryProjectionControl$";
 
 char const* const SharedMemoryPlugin::INTERNALS_TELEMETRY_FILENAME = R"(UserData\Log\RF2SMMP_InternalsTelemetryOutput.txt)";
 char const* const SharedMemoryPlugin::INTERNALS_SCORING_FILENAME = R"(UserData\Log\RF2SMMP_InternalsScoringOutput.txt)";
@@ -211,7 +335,8 @@ void __cdecl DestroyPluginObject(PluginObject* obj) { delete((SharedMemoryPlugin
 //////////////////////////////////////
 
 SharedMemoryPlugin::SharedMemoryPlugin()
-  : mTelemetry(SharedMemoryPlugin::MM_TELEMETRY_FILE_NAME)
+  : mExtStateTracker(mIDTable)
+    , mTelemetry(SharedMemoryPlugin::MM_TELEMETRY_FILE_NAME)
     , mScoring(SharedMemoryPlugin::MM_SCORING_FILE_NAME)
     , mRules(SharedMemoryPlugin::MM_RULES_FILE_NAME)
     , mMultiRules(SharedMemoryPlugin::MM_MULTI_RULES_FILE_NAME)
@@ -220,12 +345,35 @@ SharedMemoryPlugin::SharedMemoryPlugin()
     , mExtended(SharedMemoryPlugin::MM_EXTENDED_FILE_NAME)
     , mPitInfo(SharedMemoryPlugin::MM_PIT_INFO_FILE_NAME)
     , mWeather(SharedMemoryPlugin::MM_WEATHER_FILE_NAME)
+    , mTelemetryHistory(SharedMemoryPlugin::MM_TELEMETRY_HISTORY_FILE_NAME)
+    , mTelemetryLite(SharedMemoryPlugin::MM_TELEMETRY_LITE_FILE_NAME)
+    , mTelemetryProjections(SharedMemoryPlugin::MM_TELEMETRY_PROJECTIONS_FILE_NAME)
+    , mPlayerTelemetry(SharedMemoryPlugin::MM_PLAYER_TELEMETRY_FILE_NAME)
+    , mExtrapolation(SharedMemoryPlugin::MM_EXTRAPOLATION_FILE_NAME)
+    , mReaderRegistry(SharedMemoryPlugin::MM_READER_REGISTRY_FILE_NAME)
+    , mHWControlNames(SharedMemoryPlugin::MM_HWCONTROL_NAMES_FILE_NAME)
+    , mStatistics(SharedMemoryPlugin::MM_STATISTICS_FILE_NAME)
+    , mSessionTransition(SharedMemoryPlugin::MM_SESSION_TRANSITION_FILE_NAME)
+    , mEventJournal(SharedMemoryPlugin::MM_EVENT_JOURNAL_FILE_NAME)
+    , mDerivedTiming(SharedMemoryPlugin::MM_DERIVED_TIMING_FILE_NAME)
     , mHWControl(SharedMemoryPlugin::MM_HWCONTROL_FILE_NAME, rF2HWControl::SUPPORTED_LAYOUT_VERSION)
     , mWeatherControl(SharedMemoryPlugin::MM_WEATHER_CONTROL_FILE_NAME, rF2WeatherControl::SUPPORTED_LAYOUT_VERSION)
     , mRulesControl(SharedMemoryPlugin::MM_RULES_CONTROL_FILE_NAME, rF2RulesControl::SUPPORTED_LAYOUT_VERSION)
     , mPluginControl(SharedMemoryPlugin::MM_PLUGIN_CONTROL_FILE_NAME, rF2PluginControl::SUPPORTED_LAYOUT_VERSION)
+    , mTelemetryProjectionControl(SharedMemoryPlugin::MM_TELEMETRY_PROJECTION_CONTROL_FILE_NAME, rF2TelemetryProjectionControl::SUPPORTED_LAYOUT_VERSION)
 {
-  memset(mParticipantTelemetryUpdated, 0, sizeof(mParticipantTelemetryUpdated));
+  memset(mTelemetryProjectionMasks, 0, sizeof(mTelemetryProjectionMasks));
+  memset(mReaderLastHeartbeats, 0, sizeof(mReaderLastHeartbeats));
+  memset(mReaderLastHeartbeatTicks, 0, sizeof(mReaderLastHeartbeatTicks));
+  memset(mExtrapolationSnapshots, 0, sizeof(mExtrapolationSnapshots));
+
+  mTimestampTicksPerSecond = static_cast<double>(MappedBufferPlatform::GetTimestampFrequency());
+
+  for (int i = 0; i < SharedMemoryPlugin::HWCONTROL_HASH_TABLE_SIZE; ++i) {
+    mHWControlNameBuckets[i] = -1L;
+    mHWControlPointerKeys[i] = nullptr;
+    mHWControlPointerBuckets[i] = -1L;
+  }
 }
 
 
@@ -294,6 +442,12 @@ void SharedMemoryPlugin::Startup(long version)
   DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::General, "DedicatedServerMapGlobally: %d", SharedMemoryPlugin::msDedicatedServerMapGlobally);
   DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::General, "EnableDirectMemoryAccess: %d", SharedMemoryPlugin::msDirectMemoryAccessRequested);
   DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::General, "UnsubscribedBuffersMask: %ld", SharedMemoryPlugin::msUnsubscribedBuffersMask);
+  DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::General, "TripleBufferedBuffersMask: %ld", SharedMemoryPlugin::msTripleBufferedBuffersMask);
+  DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::General, "UpdateNotificationBuffersMask: %ld", SharedMemoryPlugin::msUpdateNotificationBuffersMask);
+  DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::General, "CacheLineIsolatedBuffersMask: %ld", SharedMemoryPlugin::msCacheLineIsolatedBuffersMask);
+  DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::General, "LargePagesBuffersMask: %ld", SharedMemoryPlugin::msLargePagesBuffersMask);
+  DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::General, "SuspendIdleBuffersMask: %ld", SharedMemoryPlugin::msSuspendIdleBuffersMask);
+  DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::General, "EventDrivenInputBuffers: %d", SharedMemoryPlugin::msEventDrivenInputBuffers);
   DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::General, "EnableHWControlInput: %d", SharedMemoryPlugin::msHWControlInputRequested);
   DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::General, "EnableWeatherControlInput: %d", SharedMemoryPlugin::msWeatherControlInputRequested);
   DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::General, "EnableRulesControlInput: %d", SharedMemoryPlugin::msRulesControlInputRequested);
@@ -312,20 +466,44 @@ void SharedMemoryPlugin::Startup(long version)
   RETURN_IF_FALSE(InitMappedBuffer(mGraphics, "Graphics", SubscribedBuffer::Graphics));
   RETURN_IF_FALSE(InitMappedBuffer(mPitInfo, "Pit Info", SubscribedBuffer::PitInfo));
   RETURN_IF_FALSE(InitMappedBuffer(mWeather, "Weather", SubscribedBuffer::Weather));
+  RETURN_IF_FALSE(InitMappedBuffer(mTelemetryHistory, "Telemetry History", SubscribedBuffer::TelemetryHistory));
+  RETURN_IF_FALSE(InitMappedBuffer(mTelemetryLite, "Telemetry Lite", SubscribedBuffer::TelemetryLite));
+  RETURN_IF_FALSE(InitMappedBuffer(mTelemetryProjections, "Telemetry Projections", SubscribedBuffer::TelemetryProjections));
+  RETURN_IF_FALSE(InitMappedBuffer(mPlayerTelemetry, "Player Telemetry", SubscribedBuffer::PlayerTelemetry));
+  RETURN_IF_FALSE(InitMappedBuffer(mExtrapolation, "Extrapolation", SubscribedBuffer::Extrapolation));
+  mExtrapolationStatistics = mExtrapolation.GetStatistics();
+  // Reader registry is written by the clients, and is not versioned or cleared on session restart.  It is cleared on plugin start
+  // (mapping is zeroed), so clients outliving the game find their mProcessId gone and claim a new slot (see rF2ReaderRegistry).
+  RETURN_IF_FALSE(InitMappedBuffer(mReaderRegistry, "Reader Registry", SubscribedBuffer::All));
+  RETURN_IF_FALSE(InitMappedBuffer(mHWControlNames, "HWControl Names", SubscribedBuffer::All));
+  RETURN_IF_FALSE(InitMappedBuffer(mStatistics, "Statistics", SubscribedBuffer::All));
+  RETURN_IF_FALSE(InitMappedBuffer(mSessionTransition, "Session Transition", SubscribedBuffer::All));
+  RETURN_IF_FALSE(InitMappedBuffer(mEventJournal, "Event Journal", SubscribedBuffer::EventJournal));
+  RETURN_IF_FALSE(InitMappedBuffer(mDerivedTiming, "Derived Timing", SubscribedBuffer::DerivedTiming));
   RETURN_IF_FALSE(InitMappedInputBuffer(mHWControl, "HWControl"));
   RETURN_IF_FALSE(InitMappedInputBuffer(mWeatherControl, "Weather control"));
   RETURN_IF_FALSE(InitMappedInputBuffer(mRulesControl, "Rules control"));
   RETURN_IF_FALSE(InitMappedInputBuffer(mPluginControl, "Plugin control"));
+  RETURN_IF_FALSE(InitMappedInputBuffer(mTelemetryProjectionControl, "Telemetry projection control"));
   
+  // Commands queued before the plugin started are stale.
+  MappedBufferPlatform::AtomicExchange(&(mHWControl.mpWriteBuff->mQueueReadIndex),
+    MappedBufferPlatform::AtomicLoad(&(mHWControl.mpWriteBuff->mQueueWriteIndex)));
+
   // Extended buffer is initialized last and is an indicator of initialization completed.
   RETURN_IF_FALSE(InitMappedBuffer(mExtended, "Extended", SubscribedBuffer::All));
   
   // Runtime asserts to ensure the correct layout of partially updated buffers.
-  assert(sizeof(rF2Telemetry) == offsetof(rF2Telemetry, mVehicles[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES]));
-  assert(sizeof(rF2Scoring) == offsetof(rF2Scoring, mVehicles[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES]));
+  assert(offsetof(rF2Telemetry, mVehicleChangedBits) == offsetof(rF2Telemetry, mVehicles[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES]));
+  assert(offsetof(rF2Scoring, mVehicleChangedBits) == offsetof(rF2Scoring, mVehicles[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES]));
   assert(sizeof(rF2Rules) == offsetof(rF2Rules, mParticipants[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES]));
   assert(sizeof(rF2MultiRules) == offsetof(rF2MultiRules, mParticipants[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES]));
 
+  // Struct-of-arrays buffer promises cache line aligned arrays.
+  assert(offsetof(rF2TelemetryLite, mID) == rF2MappedBufferLayout::CACHE_LINE_SIZE);
+  assert(offsetof(rF2TelemetryLite, mLapStartET) % rF2MappedBufferLayout::CACHE_LINE_SIZE == 0);
+  assert(offsetof(rF2TelemetryLite, mGear) % rF2MappedBufferLayout::CACHE_LINE_SIZE == 0);
+
   // Figure out the input buffer dependency state.
   auto hwCtrlDependencyMissing = false;
   if (SharedMemoryPlugin::msHWControlInputRequested)
@@ -340,6 +518,18 @@ void SharedMemoryPlugin::Startup(long version)
     rulesCtrlDependencyMissing = IsRulesControlInputDependencyMissing();
 
   mExtStateTracker.mExtended.mUnsubscribedBuffersMask = SharedMemoryPlugin::msUnsubscribedBuffersMask;
+  mExtStateTracker.mExtended.mTripleBufferedBuffersMask = SharedMemoryPlugin::msTripleBufferedBuffersMask;
+  mExtStateTracker.mExtended.mUpdateNotificationBuffersMask = SharedMemoryPlugin::msUpdateNotificationBuffersMask;
+  mExtStateTracker.mExtended.mCacheLineIsolatedBuffersMask = SharedMemoryPlugin::msCacheLineIsolatedBuffersMask;
+  mExtStateTracker.mExtended.mSuspendIdleBuffersMask = SharedMemoryPlugin::msSuspendIdleBuffersMask;
+  mExtStateTracker.mExtended.mEventDrivenInputBuffers = SharedMemoryPlugin::msEventDrivenInputBuffers;
+
+  // Until registry is read, assume nobody reads idle suspended buffers.
+  mExtStateTracker.mExtended.mSuspendedBuffersMask = SharedMemoryPlugin::msSuspendIdleBuffersMask;
+  if (SharedMemoryPlugin::msLargePagesBuffersMask != 0L)
+    DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::General, "Large pages requested for mask: %ld  got for mask: %ld",
+      SharedMemoryPlugin::msLargePagesBuffersMask, mExtStateTracker.mExtended.mLargePagesBuffersMask);
+
   if (SharedMemoryPlugin::msDirectMemoryAccessRequested) {
     if (!mDMR.Initialize()) {
       DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "Failed to initialize DMA, disabling DMA.");
@@ -371,9 +561,7 @@ void SharedMemoryPlugin::Startup(long version)
   // Keep multi rules as a special case for now, zero initialize here.
   mMultiRules.ClearState(nullptr /*pInitialContents*/);
 
-  mExtended.BeginUpdate();
-  memcpy(mExtended.mpWriteBuff, &(mExtStateTracker.mExtended), sizeof(rF2Extended));
-  mExtended.EndUpdate();
+  ExtendedUpdate(static_cast<unsigned long>(rF2ExtendedSection::All));
 }
 
 
@@ -430,10 +618,43 @@ void SharedMemoryPlugin::Shutdown()
   mWeather.ClearState(nullptr /*pInitialContents*/);
   mWeather.ReleaseResources();
 
+  mTelemetryHistory.ClearState(nullptr /*pInitialContents*/);
+  mTelemetryHistory.ReleaseResources();
+
+  mTelemetryLite.ClearState(nullptr /*pInitialContents*/);
+  mTelemetryLite.ReleaseResources();
+
+  mTelemetryProjections.ClearState(nullptr /*pInitialContents*/);
+  mTelemetryProjections.ReleaseResources();
+
+  mPlayerTelemetry.ClearState(nullptr /*pInitialContents*/);
+  mPlayerTelemetry.ReleaseResources();
+
+  mExtrapolation.ClearState(nullptr /*pInitialContents*/);
+  mExtrapolation.ReleaseResources();
+
+  mReaderRegistry.ReleaseResources();
+
+  mHWControlNames.ClearState(nullptr /*pInitialContents*/);
+  mHWControlNames.ReleaseResources();
+
+  mStatistics.ClearState(nullptr /*pInitialContents*/);
+  mStatistics.ReleaseResources();
+
+  mSessionTransition.ClearState(nullptr /*pInitialContents*/);
+  mSessionTransition.ReleaseResources();
+
+  mEventJournal.ClearState(nullptr /*pInitialContents*/);
+  mEventJournal.ReleaseResources();
+
+  mDerivedTiming.ClearState(nullptr /*pInitialContents*/);
+  mDerivedTiming.ReleaseResources();
+
   mHWControl.ReleaseResources();
   mWeatherControl.ReleaseResources();
   mRulesControl.ReleaseResources();
   mPluginControl.ReleaseResources();
+  mTelemetryProjectionControl.ReleaseResources();
 }
 
 void SharedMemoryPlugin::ClearTimingsAndCounters()
@@ -451,7 +672,15 @@ void SharedMemoryPlugin::ClearTimingsAndCounters()
 
   mCurrTelemetryVehicleIndex = 0;
 
-  memset(mParticipantTelemetryUpdated, 0, sizeof(mParticipantTelemetryUpdated));
+  mIDTable.Clear();
+
+  mPlayerTelemetryID = -1L;
+
+  mDerivedTimingNumVehicles = 0L;
+  mDerivedTimingScoringET = -1.0;
+
+  // Captured frame and the Extrapolation buffer are owned by the multimedia thread, so it clears them (see ExtrapolationUpdate).
+  MappedBufferPlatform::AtomicExchange(&mExtrapolationClearRequested, 1uL);
 
   mLastUpdateLSIWasVisible = false;
 
@@ -463,6 +692,9 @@ void SharedMemoryPlugin::ClearTimingsAndCounters()
   mHWControlRequestBoostCounter = 0;
   
   mHWControlInputRequestReceived = false;
+  // Queued command is not popped until applied, so it will be picked up again.
+  mHWControlCommandQueued = false;
+  mHWControlQueueStallCounter = 0;
   mWeatherControlInputRequestReceived = false;
   mRulesControlInputRequestReceived = false;
 }
@@ -473,6 +705,9 @@ void SharedMemoryPlugin::ClearState()
   if (!mIsMapped)
     return;
 
+  // Complete the frame in progress first, so that vehicles written into it are accounted for by mTelemetry.ClearState.
+  TelemetryCompleteFrame();
+
   mTelemetry.ClearState(nullptr /*pInitialContents*/);
   mScoring.ClearState(nullptr /*pInitialContents*/);
   mRules.ClearState(nullptr /*pInitialContents*/);
@@ -481,11 +716,20 @@ void SharedMemoryPlugin::ClearState()
   // Do not clear mMultiRules as they're updated in between sessions.
   mPitInfo.ClearState(nullptr /*pInitialContents*/);
   mWeather.ClearState(nullptr /*pInitialContents*/);
+  mTelemetryHistory.ClearState(nullptr /*pInitialContents*/);
+  mTelemetryLite.ClearState(nullptr /*pInitialContents*/);
+  mTelemetryProjections.ClearState(nullptr /*pInitialContents*/);
+  mPlayerTelemetry.ClearState(nullptr /*pInitialContents*/);
+  // mExtrapolation is cleared on the multimedia thread, on request from ClearTimingsAndCounters.
+  mDerivedTiming.ClearState(nullptr /*pInitialContents*/);
 
   // Certain members of the extended state persist between restarts/sessions.
   // So, clear the state but pass persisting state as initial state.
   mExtStateTracker.ClearState();
+  MarkExtendedSectionsUpdated(static_cast<unsigned long>(rF2ExtendedSection::All));
   mExtended.ClearState(&(mExtStateTracker.mExtended));
+  mExtStateTracker.FlushDirtyDamageSlots(nullptr /*pDest*/);
+  mExtStateTracker.FlushImpacts(nullptr /*pDest*/);
 
   ClearTimingsAndCounters();
 }
@@ -508,6 +752,7 @@ void SharedMemoryPlugin::StartSession()
   // it might be overwritten by the next session.
   // Current read buffer for Scoring info contains last Scoring Update.
   mExtStateTracker.CaptureSessionTransition(*mScoring.mpWriteBuff);
+  SessionTransitionUpdate(false /*sessionEnded*/);
 
   if (SharedMemoryPlugin::msDirectMemoryAccessRequested) {
     if (!mDMR.ReadOnNewSession(mExtStateTracker.mExtended)) {
@@ -540,10 +785,35 @@ void SharedMemoryPlugin::EndSession()
 
   // Capture Session End state.
   mExtStateTracker.CaptureSessionTransition(*mScoring.mpWriteBuff);
+  SessionTransitionUpdate(true /*sessionEnded*/);
 
-  mExtended.BeginUpdate();
-  memcpy(mExtended.mpWriteBuff, &(mExtStateTracker.mExtended), sizeof(rF2Extended));
-  mExtended.EndUpdate();
+  ExtendedUpdate(static_cast<unsigned long>(rF2ExtendedSection::CallbackFlags) | static_cast<unsigned long>(rF2ExtendedSection::SessionCapture));
+}
+
+
+// Captures last published Scoring and Rules.  Called before ClearState, so they still hold the previous session's state.
+void SharedMemoryPlugin::SessionTransitionUpdate(bool sessionEnded)
+{
+  mSessionTransition.BeginUpdate();
+
+  // Mapped with SubscribedBuffer::All (regular layout), so the frame not written here keeps its published value.
+  auto& transition = *mSessionTransition.mpWriteBuff;
+  auto& frame = sessionEnded ? transition.mSessionEnd : transition.mSessionStart;
+  frame.mSequence = transition.mLastSequence + 1uL;
+  frame.mTicksCaptured = sessionEnded ? mExtStateTracker.mExtended.mTicksSessionEnded : mExtStateTracker.mExtended.mTicksSessionStarted;
+
+  auto const& scoring = *mScoring.GetPublishedBuff();
+  memcpy(&(frame.mScoringInfo), &(scoring.mScoringInfo), sizeof(rF2ScoringInfo));
+  memcpy(frame.mScoringVehicles, scoring.mVehicles, sizeof(frame.mScoringVehicles));
+
+  auto const& rules = *mRules.GetPublishedBuff();
+  memcpy(&(frame.mTrackRules), &(rules.mTrackRules), sizeof(rF2TrackRules));
+  memcpy(frame.mRulesActions, rules.mActions, sizeof(frame.mRulesActions));
+  memcpy(frame.mRulesParticipants, rules.mParticipants, sizeof(frame.mRulesParticipants));
+
+  transition.mLastSequence = frame.mSequence;
+
+  mSessionTransition.EndUpdate(frame.mScoringInfo.mCurrentET);
 }
 
 
@@ -558,9 +828,7 @@ void SharedMemoryPlugin::UpdateInRealtimeFC(bool inRealTime)
   if (!inRealTime)
     mExtStateTracker.ResetDamageState();
 
-  mExtended.BeginUpdate();
-  memcpy(mExtended.mpWriteBuff, &(mExtStateTracker.mExtended), sizeof(rF2Extended));
-  mExtended.EndUpdate();
+  ExtendedUpdate(static_cast<unsigned long>(rF2ExtendedSection::CallbackFlags) | static_cast<unsigned long>(rF2ExtendedSection::Damage));
 }
 
 
@@ -697,7 +965,7 @@ void SharedMemoryPlugin::TelemetryBeginNewFrame(TelemInfoV01 const& info, double
 {
   TelemetryTraceBeginUpdate(info.mElapsedTime, deltaET);
 
-  memset(mParticipantTelemetryUpdated, 0, sizeof(mParticipantTelemetryUpdated));
+  mIDTable.NextGeneration();
 
   mTelemetryFrameCompleted = false;
   mCurrTelemetryVehicleIndex = 0;
@@ -707,24 +975,458 @@ void SharedMemoryPlugin::TelemetryBeginNewFrame(TelemInfoV01 const& info, double
   mLastTelemetryUpdateET = info.mElapsedTime;
 
   mTelemetry.BeginUpdate();
+
+  memset(mTelemetry.mpWriteBuff->mVehicleChangedBits, 0, sizeof(mTelemetry.mpWriteBuff->mVehicleChangedBits));
+}
+
+// Works for both rF2VehicleTelemetry and rF2VehicleScoring.
+template <typename VehicleT>
+static void BuildVehicleIDIndex(rF2VehicleIDIndex& index, VehicleT const* const vehicles, int numVehicles)
+{
+  static_assert(rF2MappedBufferHeader::MAX_MAPPED_VEHICLES <= 256, "Vehicle index does not fit mVehicleIndices.");
+
+  // Every slot has to be written, see MappedBuffer<> triple buffered layout.
+  memset(index.mIDs, -1, sizeof(index.mIDs));
+  memset(index.mVehicleIndices, 0, sizeof(index.mVehicleIndices));
+
+  for (int i = 0; i < numVehicles; ++i) {
+    auto const id = max(vehicles[i].mID, 0L);
+    auto slot = id % rF2VehicleIDIndex::NUM_SLOTS;
+
+    // Table can't fill up, NUM_SLOTS is twice the max number of vehicles.
+    while (index.mIDs[slot] != -1L && index.mIDs[slot] != id)
+      slot = (slot + 1L) % rF2VehicleIDIndex::NUM_SLOTS;
+
+    if (index.mIDs[slot] == id) {
+      DEBUG_MSG(DebugLevel::Warnings, DebugSource::General, "Vehicle ID index: duplicate mID: %ld.", id);
+      continue;  // First vehicle wins.
+    }
+
+    index.mIDs[slot] = id;
+    index.mVehicleIndices[slot] = static_cast<unsigned char>(i);
+  }
+}
+
+
+static void BuildPlaceOrder(rF2Scoring& scoring, int numVehicles)
+{
+  // Insertion sort, vehicles are mostly sorted already, and stable order of ties is preserved.
+  for (int i = 0; i < numVehicles; ++i) {
+    auto const vehIndex = static_cast<unsigned char>(i);
+    auto const place = scoring.mVehicles[i].mPlace;
+
+    auto j = i;
+    for (; j > 0 && scoring.mVehicles[scoring.mPlaceOrder[j - 1]].mPlace > place; --j)
+      scoring.mPlaceOrder[j] = scoring.mPlaceOrder[j - 1];
+
+    scoring.mPlaceOrder[j] = vehIndex;
+  }
+
+  // Every entry has to be written, see MappedBuffer<> triple buffered layout.
+  if (numVehicles < rF2MappedBufferHeader::MAX_MAPPED_VEHICLES)
+    memset(scoring.mPlaceOrder + numVehicles, 0, sizeof(scoring.mPlaceOrder) - numVehicles);
 }
 
+
 void SharedMemoryPlugin::TelemetryCompleteFrame()
 {
   if (mTelemetryFrameCompleted)
     return;
 
+  // Might be called from other callbacks, which did not resume it.
+  mTelemetry.ResumeUpdateTiming();
+
   mTelemetry.mpWriteBuff->mNumVehicles = mCurrTelemetryVehicleIndex;
   mTelemetry.mpWriteBuff->mBytesUpdatedHint = static_cast<int>(offsetof(rF2Telemetry, mVehicles[mTelemetry.mpWriteBuff->mNumVehicles]));
 
-  mTelemetry.EndUpdate();
+  BuildVehicleIDIndex(mTelemetry.mpWriteBuff->mVehicleIDIndex, mTelemetry.mpWriteBuff->mVehicles, mTelemetry.mpWriteBuff->mNumVehicles);
+
+  mTelemetry.EndUpdate(mLastTelemetryUpdateET);
 
   TelemetryTraceEndUpdate(mTelemetry.mpWriteBuff->mNumVehicles);
 
+  TelemetryHistoryAppendFrame();
+  TelemetryLiteUpdate();
+  TelemetryProjectionsUpdate();
+  ExtrapolationCaptureFrame();
+  DerivedTimingPublish();
+
+  if (SharedMemoryPlugin::msEventDrivenInputBuffers) {
+    ReadPluginControl();
+    ReadTelemetryProjectionControl();
+  }
+
   mTelemetryFrameCompleted = true;
 }
 
 
+void SharedMemoryPlugin::TelemetryHistoryAppendFrame()
+{
+  if (Utils::IsFlagOn(SharedMemoryPlugin::msUnsubscribedBuffersMask, SubscribedBuffer::TelemetryHistory)
+    || IsBufferSuspended(SubscribedBuffer::TelemetryHistory))
+    return;
+
+  // Note: mpWriteBuff still points at the frame just completed.
+  auto const& telemetry = *mTelemetry.mpWriteBuff;
+  auto& history = *mTelemetryHistory.mpWriteBuff;
+
+  auto const numVehicles = static_cast<unsigned long>(max(telemetry.mNumVehicles, 0L));
+  auto const sequence = history.mLastSequence + 1uL;
+  auto& frame = history.mFrames[sequence % rF2TelemetryHistory::MAX_FRAMES];
+
+  mTelemetryHistory.BeginUpdate();
+
+  // Invalidate the slot and claim pool space before overwriting anything, so that reader lapped by the plugin can detect that.
+  MappedBufferPlatform::AtomicExchange(&frame.mSequence, 0uL);
+  auto const firstVehicle = history.mVehiclesWritten;
+  MappedBufferPlatform::AtomicExchange(&history.mVehiclesWritten, firstVehicle + numVehicles);
+
+  // Copy vehicles, wrapping around the end of the pool if necessary.
+  auto const poolIndex = firstVehicle % rF2TelemetryHistory::MAX_VEHICLE_SLOTS;
+  auto const numBeforeWrap = min(numVehicles, rF2TelemetryHistory::MAX_VEHICLE_SLOTS - poolIndex);
+  memcpy(&(history.mVehicles[poolIndex]), &(telemetry.mVehicles[0]), numBeforeWrap * sizeof(rF2VehicleTelemetry));
+  if (numVehicles > numBeforeWrap)
+    memcpy(&(history.mVehicles[0]), &(telemetry.mVehicles[numBeforeWrap]), (numVehicles - numBeforeWrap) * sizeof(rF2VehicleTelemetry));
+
+  frame.mElapsedTime = mLastTelemetryUpdateET;
+  frame.mNumVehicles = static_cast<long>(numVehicles);
+  frame.mFirstVehicle = firstVehicle;
+
+  // Drop the oldest frames whose vehicles were overwritten by this one, or which fell out of mFrames.
+  auto readableFrames = min(history.mReadableFrames + 1uL, static_cast<unsigned long>(rF2TelemetryHistory::MAX_FRAMES));
+  while (readableFrames > 1uL
+    && history.mVehiclesWritten - history.mFrames[(sequence - readableFrames + 1uL) % rF2TelemetryHistory::MAX_FRAMES].mFirstVehicle
+      > rF2TelemetryHistory::MAX_VEHICLE_SLOTS)
+    --readableFrames;
+
+  // Publish the frame.
+  MappedBufferPlatform::AtomicExchange(&frame.mSequence, sequence);
+  MappedBufferPlatform::AtomicExchange(&history.mLastSequence, sequence);
+  MappedBufferPlatform::AtomicExchange(&history.mReadableFrames, readableFrames);
+
+  mTelemetryHistory.EndUpdate(mLastTelemetryUpdateET);
+}
+
+
+void SharedMemoryPlugin::TelemetryLiteUpdate()
+{
+  if (Utils::IsFlagOn(SharedMemoryPlugin::msUnsubscribedBuffersMask, SubscribedBuffer::TelemetryLite)
+    || IsBufferSuspended(SubscribedBuffer::TelemetryLite))
+    return;
+
+  // Note: mpWriteBuff still points at the frame just completed.
+  auto const& telemetry = *mTelemetry.mpWriteBuff;
+  auto const numVehicles = min(max(telemetry.mNumVehicles, 0L), static_cast<long>(rF2MappedBufferHeader::MAX_MAPPED_VEHICLES));
+
+  mTelemetryLite.BeginUpdate();
+
+  auto& lite = *mTelemetryLite.mpWriteBuff;
+  lite.mElapsedTime = mLastTelemetryUpdateET;
+  lite.mNumVehicles = numVehicles;
+
+  for (int i = 0; i < numVehicles; ++i) {
+    auto const& vt = telemetry.mVehicles[i];
+
+    lite.mID[i] = vt.mID;
+    lite.mLapNumber[i] = vt.mLapNumber;
+    lite.mCurrentSector[i] = vt.mCurrentSector;
+    lite.mLapStartET[i] = vt.mLapStartET;
+
+    lite.mPosX[i] = static_cast<float>(vt.mPos.x);
+    lite.mPosY[i] = static_cast<float>(vt.mPos.y);
+    lite.mPosZ[i] = static_cast<float>(vt.mPos.z);
+    lite.mSpeed[i] = static_cast<float>(sqrt(vt.mLocalVel.x * vt.mLocalVel.x + vt.mLocalVel.y * vt.mLocalVel.y + vt.mLocalVel.z * vt.mLocalVel.z));
+
+    lite.mEngineRPM[i] = static_cast<float>(vt.mEngineRPM);
+    lite.mEngineMaxRPM[i] = static_cast<float>(vt.mEngineMaxRPM);
+
+    lite.mFilteredThrottle[i] = static_cast<float>(vt.mFilteredThrottle);
+    lite.mFilteredBrake[i] = static_cast<float>(vt.mFilteredBrake);
+    lite.mFilteredClutch[i] = static_cast<float>(vt.mFilteredClutch);
+    lite.mFilteredSteering[i] = static_cast<float>(vt.mFilteredSteering);
+
+    lite.mFuel[i] = static_cast<float>(vt.mFuel);
+    lite.mFuelCapacity[i] = static_cast<float>(vt.mFuelCapacity);
+
+    lite.mGear[i] = static_cast<signed char>(vt.mGear);
+    lite.mMaxGears[i] = vt.mMaxGears;
+  }
+
+  mTelemetryLite.EndUpdate(mLastTelemetryUpdateET);
+}
+
+
+// Ranges of rF2VehicleTelemetry covered by each rF2TelemetryFieldGroup flag, in the flag order.
+static struct
+{
+  size_t mBegin;
+  size_t mEnd;
+} const TELEMETRY_FIELD_GROUP_RANGES[] =
+{
+  { offsetof(rF2VehicleTelemetry, mID), offsetof(rF2VehicleTelemetry, mVehicleName) },                         // Time
+  { offsetof(rF2VehicleTelemetry, mVehicleName), offsetof(rF2VehicleTelemetry, mPos) },                        // Names
+  { offsetof(rF2VehicleTelemetry, mPos), offsetof(rF2VehicleTelemetry, mOri) },                                // Position
+  { offsetof(rF2VehicleTelemetry, mOri), offsetof(rF2VehicleTelemetry, mGear) },                               // Orientation
+  { offsetof(rF2VehicleTelemetry, mGear), offsetof(rF2VehicleTelemetry, mUnfilteredThrottle) },                // VehicleStatus
+  { offsetof(rF2VehicleTelemetry, mUnfilteredThrottle), offsetof(rF2VehicleTelemetry, mFilteredThrottle) },    // UnfilteredInput
+  { offsetof(rF2VehicleTelemetry, mFilteredThrottle), offsetof(rF2VehicleTelemetry, mSteeringShaftTorque) },   // FilteredInput
+  { offsetof(rF2VehicleTelemetry, mSteeringShaftTorque), offsetof(rF2VehicleTelemetry, mFrontWingHeight) },    // Misc
+  { offsetof(rF2VehicleTelemetry, mFrontWingHeight), offsetof(rF2VehicleTelemetry, mFuel) },                   // Aerodynamics
+  { offsetof(rF2VehicleTelemetry, mFuel), offsetof(rF2VehicleTelemetry, mEngineTorque) },                      // StateDamage
+  { offsetof(rF2VehicleTelemetry, mEngineTorque), offsetof(rF2VehicleTelemetry, mExpansion) },                 // Expanded
+  { offsetof(rF2VehicleTelemetry, mWheels), sizeof(rF2VehicleTelemetry) }                                      // Wheels
+};
+
+static int const NUM_TELEMETRY_FIELD_GROUPS = sizeof(TELEMETRY_FIELD_GROUP_RANGES) / sizeof(TELEMETRY_FIELD_GROUP_RANGES[0]);
+
+
+void SharedMemoryPlugin::TelemetryProjectionsUpdate()
+{
+  if (Utils::IsFlagOn(SharedMemoryPlugin::msUnsubscribedBuffersMask, SubscribedBuffer::TelemetryProjections)
+    || IsBufferSuspended(SubscribedBuffer::TelemetryProjections))
+    return;
+
+  // Note: mpWriteBuff still points at the frame just completed.
+  auto const& telemetry = *mTelemetry.mpWriteBuff;
+  auto const numVehicles = min(max(telemetry.mNumVehicles, 0L), static_cast<long>(rF2MappedBufferHeader::MAX_MAPPED_VEHICLES));
+
+  mTelemetryProjections.BeginUpdate();
+
+  auto& projections = *mTelemetryProjections.mpWriteBuff;
+  auto bytesUpdated = static_cast<int>(offsetof(rF2TelemetryProjections, mProjections[0]));
+  for (int p = 0; p < rF2TelemetryProjections::MAX_PROJECTIONS; ++p) {
+    auto& projection = projections.mProjections[p];
+    auto const mask = mTelemetryProjectionMasks[p];
+
+    if (mask == 0uL) {
+      if (projection.mFieldGroupsMask != 0uL) {
+        // Deactivated since the last frame.
+        projection.mFieldGroupsMask = 0uL;
+        projection.mRecordSize = 0L;
+        projection.mNumVehicles = 0L;
+        projection.mElapsedTime = 0.0;
+        bytesUpdated = static_cast<int>(offsetof(rF2TelemetryProjections, mProjections[p].mRecords));
+      }
+
+      continue;
+    }
+
+    // Gather the ranges to copy, merging the adjacent ones.
+    size_t begins[NUM_TELEMETRY_FIELD_GROUPS] = {};
+    size_t sizes[NUM_TELEMETRY_FIELD_GROUPS] = {};
+    auto numRanges = 0;
+    auto recordSize = 0L;
+    for (int g = 0; g < NUM_TELEMETRY_FIELD_GROUPS; ++g) {
+      if ((mask & (1uL << g)) == 0uL)
+        continue;
+
+      auto const& range = TELEMETRY_FIELD_GROUP_RANGES[g];
+      if (numRanges > 0 && begins[numRanges - 1] + sizes[numRanges - 1] == range.mBegin)
+        sizes[numRanges - 1] += range.mEnd - range.mBegin;
+      else {
+        begins[numRanges] = range.mBegin;
+        sizes[numRanges] = range.mEnd - range.mBegin;
+        ++numRanges;
+      }
+
+      recordSize += static_cast<long>(range.mEnd - range.mBegin);
+    }
+
+    projection.mFieldGroupsMask = mask;
+    projection.mRecordSize = recordSize;
+    projection.mNumVehicles = numVehicles;
+    projection.mElapsedTime = mLastTelemetryUpdateET;
+
+    auto pRecord = projection.mRecords;
+    for (int i = 0; i < numVehicles; ++i) {
+      auto const pVehicle = reinterpret_cast<unsigned char const*>(&(telemetry.mVehicles[i]));
+      for (int r = 0; r < numRanges; ++r) {
+        memcpy(pRecord, pVehicle + begins[r], sizes[r]);
+        pRecord += sizes[r];
+      }
+    }
+
+    bytesUpdated = static_cast<int>(offsetof(rF2TelemetryProjections, mProjections[p].mRecords) + numVehicles * recordSize);
+  }
+
+  projections.mBytesUpdatedHint = bytesUpdated;
+
+  mTelemetryProjections.EndUpdate(mLastTelemetryUpdateET);
+}
+
+
+// Invoked on every player vehicle telemetry update, including the ones frame assembly drops.
+void SharedMemoryPlugin::PlayerTelemetryUpdate(TelemInfoV01 const& info)
+{
+  if (Utils::IsFlagOn(SharedMemoryPlugin::msUnsubscribedBuffersMask, SubscribedBuffer::PlayerTelemetry)
+    || IsBufferSuspended(SubscribedBuffer::PlayerTelemetry))
+    return;
+
+  auto const now = MappedBufferPlatform::QueryTimestamp();
+
+  mPlayerTelemetry.BeginUpdate();
+
+  mPlayerTelemetry.mpWriteBuff->mTimestamp = now;
+  memcpy(&(mPlayerTelemetry.mpWriteBuff->mVehicle), &info, sizeof(rF2VehicleTelemetry));
+
+  mPlayerTelemetry.EndUpdate(info.mElapsedTime);
+}
+
+
+// Telemetry frames normally arrive every 20ms, so this allows a few late frames before vehicles stop.
+static double const MAX_EXTRAPOLATION_SECONDS = 0.1;
+
+static double Dot(rF2Vec3 const& a, rF2Vec3 const& b)
+{
+  return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+
+// Captures motion state of the vehicles in the frame just completed, ExtrapolationUpdate predicts from it.  Invoked on
+// the simulation thread, the snapshot is written into the slot owned by this thread and then swapped with the latest one.
+void SharedMemoryPlugin::ExtrapolationCaptureFrame()
+{
+  if (Utils::IsFlagOn(SharedMemoryPlugin::msUnsubscribedBuffersMask, SubscribedBuffer::Extrapolation)
+    || IsBufferSuspended(SubscribedBuffer::Extrapolation))
+    return;
+
+  // Note: mpWriteBuff still points at the frame just completed.
+  auto const& telemetry = *mTelemetry.mpWriteBuff;
+  auto const numVehicles = min(max(telemetry.mNumVehicles, 0L), static_cast<long>(rF2MappedBufferHeader::MAX_MAPPED_VEHICLES));
+  auto& snapshot = mExtrapolationSnapshots[mExtrapolationCaptureSlot];
+
+  for (int i = 0; i < numVehicles; ++i) {
+    auto const& vt = telemetry.mVehicles[i];
+    auto& motion = snapshot.mVehicles[i];
+
+    motion.mID = vt.mID;
+    motion.mElapsedTime = vt.mElapsedTime;
+    motion.mPos = vt.mPos;
+    motion.mLocalVel = vt.mLocalVel;
+    motion.mLocalAccel = vt.mLocalAccel;
+    memcpy(motion.mOri, vt.mOri, sizeof(motion.mOri));
+    motion.mLocalRot = vt.mLocalRot;
+  }
+
+  snapshot.mNumVehicles = numVehicles;
+  snapshot.mSourceET = mLastTelemetryUpdateET;
+  snapshot.mTimestamp = MappedBufferPlatform::QueryTimestamp();
+
+  // Previous latest snapshot, if not taken by the multimedia thread, is dropped and becomes the next capture slot.
+  mExtrapolationCaptureSlot = MappedBufferPlatform::AtomicExchange(&mExtrapolationLatestSlot,
+    mExtrapolationCaptureSlot | SharedMemoryPlugin::EXTRAPOLATION_SNAPSHOT_FRESH) & ~SharedMemoryPlugin::EXTRAPOLATION_SNAPSHOT_FRESH;
+}
+
+
+// Invoked on each graphics update (~400FPS), on the multimedia thread.  This is the only thread writing mExtrapolation.
+void SharedMemoryPlugin::ExtrapolationUpdate()
+{
+  auto const clearRequested = MappedBufferPlatform::AtomicExchange(&mExtrapolationClearRequested, 0uL) != 0uL;
+  if (clearRequested
+    || (MappedBufferPlatform::AtomicLoad(&mExtrapolationLatestSlot) & SharedMemoryPlugin::EXTRAPOLATION_SNAPSHOT_FRESH) != 0uL) {
+    mExtrapolationReadSlot = MappedBufferPlatform::AtomicExchange(&mExtrapolationLatestSlot, mExtrapolationReadSlot)
+      & ~SharedMemoryPlugin::EXTRAPOLATION_SNAPSHOT_FRESH;
+  }
+
+  auto& source = mExtrapolationSnapshots[mExtrapolationReadSlot];
+  if (clearRequested) {
+    // Frames captured before the clear request are gone with the swap above, or are never taken again.
+    source.mNumVehicles = 0L;
+    mExtrapolation.ClearState(nullptr /*pInitialContents*/);
+    ExtrapolationPublishStatistics();
+  }
+
+  if (Utils::IsFlagOn(SharedMemoryPlugin::msUnsubscribedBuffersMask, SubscribedBuffer::Extrapolation)
+    || IsBufferSuspended(SubscribedBuffer::Extrapolation)
+    || source.mNumVehicles == 0L)
+    return;
+
+  // Game ET is not available here, so advance the frame ET by the wall clock time passed since the frame was captured.
+  auto const now = MappedBufferPlatform::QueryTimestamp();
+  auto const sinceCapture = static_cast<double>(now - source.mTimestamp) / mTimestampTicksPerSecond;
+  auto const predictionET = source.mSourceET + min(sinceCapture, MAX_EXTRAPOLATION_SECONDS);
+
+  mExtrapolation.BeginUpdate();
+
+  auto& extrapolation = *mExtrapolation.mpWriteBuff;
+  extrapolation.mTimestamp = now;
+  extrapolation.mElapsedTime = predictionET;
+  extrapolation.mSourceElapsedTime = source.mSourceET;
+  extrapolation.mNumVehicles = source.mNumVehicles;
+
+  for (int i = 0; i < source.mNumVehicles; ++i) {
+    auto const& motion = source.mVehicles[i];
+
+    // Vehicles in the frame are not updated at exactly the same ET.
+    auto const dt = min(max(predictionET - motion.mElapsedTime, 0.0), MAX_EXTRAPOLATION_SECONDS);
+    SharedMemoryPlugin::ExtrapolateVehicleMotion(motion, dt, extrapolation.mVehicles[i]);
+  }
+
+  extrapolation.mBytesUpdatedHint = static_cast<int>(offsetof(rF2Extrapolation, mVehicles[source.mNumVehicles]));
+
+  mExtrapolation.EndUpdate(predictionET);
+  ExtrapolationPublishStatistics();
+}
+
+
+// Copies mExtrapolation statistics for StatisticsUpdate, which runs on the simulation thread.
+void SharedMemoryPlugin::ExtrapolationPublishStatistics()
+{
+  MappedBufferPlatform::AtomicIncrement(&mExtrapolationStatisticsVersion);
+  mExtrapolationStatistics = mExtrapolation.GetStatistics();
+  MappedBufferPlatform::AtomicIncrement(&mExtrapolationStatisticsVersion);
+}
+
+
+// Position is extrapolated assuming constant acceleration, orientation assuming constant angular velocity.  Local vectors
+// are converted to the world coordinates via dot product with mOri rows.
+void SharedMemoryPlugin::ExtrapolateVehicleMotion(VehicleMotion const& motion, double dt, rF2VehicleExtrapolation& vehicle)
+{
+  vehicle.mID = motion.mID;
+  vehicle.mExtrapolationTime = dt;
+
+  auto const& lv = motion.mLocalVel;
+  auto const& la = motion.mLocalAccel;
+  rF2Vec3 const localOffset = { lv.x * dt + 0.5 * la.x * dt * dt, lv.y * dt + 0.5 * la.y * dt * dt, lv.z * dt + 0.5 * la.z * dt * dt };
+  rF2Vec3 const localVel = { lv.x + la.x * dt, lv.y + la.y * dt, lv.z + la.z * dt };
+
+  vehicle.mPos.x = motion.mPos.x + Dot(motion.mOri[0], localOffset);
+  vehicle.mPos.y = motion.mPos.y + Dot(motion.mOri[1], localOffset);
+  vehicle.mPos.z = motion.mPos.z + Dot(motion.mOri[2], localOffset);
+
+  vehicle.mWorldVel.x = Dot(motion.mOri[0], localVel);
+  vehicle.mWorldVel.y = Dot(motion.mOri[1], localVel);
+  vehicle.mWorldVel.z = Dot(motion.mOri[2], localVel);
+
+  auto const& w = motion.mLocalRot;
+  auto const rate = sqrt(Dot(w, w));
+  auto const angle = rate * dt;
+  if (angle < 1.0e-9) {
+    memcpy(vehicle.mOri, motion.mOri, sizeof(vehicle.mOri));
+    return;
+  }
+
+  // Rotation by angle around the local axis (Rodrigues' formula), applied in the vehicle frame: Ori' = Ori * R.
+  auto const kx = w.x / rate;
+  auto const ky = w.y / rate;
+  auto const kz = w.z / rate;
+  auto const c = cos(angle);
+  auto const s = sin(angle);
+  auto const t = 1.0 - c;
+
+  // Columns of R.
+  rF2Vec3 const rCol0 = { t * kx * kx + c, t * kx * ky + s * kz, t * kx * kz - s * ky };
+  rF2Vec3 const rCol1 = { t * kx * ky - s * kz, t * ky * ky + c, t * ky * kz + s * kx };
+  rF2Vec3 const rCol2 = { t * kx * kz + s * ky, t * ky * kz - s * kx, t * kz * kz + c };
+
+  for (int row = 0; row < 3; ++row) {
+    vehicle.mOri[row].x = Dot(motion.mOri[row], rCol0);
+    vehicle.mOri[row].y = Dot(motion.mOri[row], rCol1);
+    vehicle.mOri[row].z = Dot(motion.mOri[row], rCol2);
+  }
+}
+
+
 /*
 rF2 sends telemetry updates for each vehicle.  The problem is that we do not know when all vehicles received an update.
 Below I am trying to complete buffer update per-frame, where "frame" means all vehicles received telemetry update.
@@ -749,6 +1451,18 @@ void SharedMemoryPlugin::UpdateTelemetry(TelemInfoV01 const& info)
   if (!mIsMapped)
     return;
 
+  if (info.mID == mPlayerTelemetryID)
+    PlayerTelemetryUpdate(info);
+
+  // Frame is assembled over many calls, only count time spent in them.
+  mTelemetry.ResumeUpdateTiming();
+  TelemetryUpdateFrame(info);
+  mTelemetry.PauseUpdateTiming();
+}
+
+
+void SharedMemoryPlugin::TelemetryUpdateFrame(TelemInfoV01 const& info)
+{
   bool isNewFrame = false;
   auto const deltaET = info.mElapsedTime - mLastTelemetryUpdateET;
   if (abs(deltaET) >= 0.0199)  // Apparently, rF2 telemetry update step is 20ms.
@@ -778,9 +1492,18 @@ void SharedMemoryPlugin::UpdateTelemetry(TelemInfoV01 const& info)
     return;  // Nothing to do.
   }
 
+  auto slotAssigned = false;
+  auto const slot = mIDTable.FindOrAdd(info.mID, slotAssigned);
+  if (slot == -1L) {
+    DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "TELEMETRY - Exceeded maximum of allowed mapped IDs.");
+    return;
+  }
+
+  if (slotAssigned)
+    mExtStateTracker.ResetSlotDamageState(slot);
+
   // See if we are in a cycle.
-  auto const participantIndex = max(info.mID, 0L) % rF2Extended::MAX_MAPPED_IDS;
-  auto const alreadyUpdated = mParticipantTelemetryUpdated[participantIndex];
+  auto const alreadyUpdated = mIDTable.IsStamped(slot);
 
   if (!alreadyUpdated) {
     if (mCurrTelemetryVehicleIndex >= rF2MappedBufferHeader::MAX_MAPPED_VEHICLES) {
@@ -791,14 +1514,20 @@ void SharedMemoryPlugin::UpdateTelemetry(TelemInfoV01 const& info)
     // Update extended state for this vehicle.
     // Since I do not want to miss impact data, and it is not accumulated in any way
     // I am aware of in rF2 internals, process on every telemetry update.  Actual buffer update will happen on Scoring update.
-    mExtStateTracker.ProcessTelemetryUpdate(info);
+    mExtStateTracker.ProcessTelemetryUpdate(info, slot);
 
     // Mark participant as updated
-    assert(mParticipantTelemetryUpdated[participantIndex] == false);
-    mParticipantTelemetryUpdated[participantIndex] = true;
+    mIDTable.Stamp(slot);
 
     TelemetryTraceVehicleAdded(info);
 
+    // Track if vehicle changed since the last frame.  Time stamps tick for every vehicle, so skip them.
+    static auto const COMPARE_OFFSET = offsetof(rF2VehicleTelemetry, mLapNumber);
+    auto const& prevVehicle = mTelemetry.GetPublishedBuff()->mVehicles[mCurrTelemetryVehicleIndex];
+    if (prevVehicle.mID != info.mID
+      || memcmp(reinterpret_cast<char const*>(&prevVehicle) + COMPARE_OFFSET, reinterpret_cast<char const*>(&info) + COMPARE_OFFSET, sizeof(rF2VehicleTelemetry) - COMPARE_OFFSET) != 0)
+      mTelemetry.mpWriteBuff->mVehicleChangedBits[mCurrTelemetryVehicleIndex / 8] |= static_cast<unsigned char>(1u << (mCurrTelemetryVehicleIndex % 8));
+
     // Write vehicle telemetry.
     memcpy(&(mTelemetry.mpWriteBuff->mVehicles[mCurrTelemetryVehicleIndex]), &info, sizeof(rF2VehicleTelemetry));
     ++mCurrTelemetryVehicleIndex;
@@ -837,13 +1566,35 @@ bool SharedMemoryPlugin::InitMappedBuffer(BuffT& buffer, char const* const buffL
     && Utils::IsFlagOn(SharedMemoryPlugin::msUnsubscribedBuffersMask, sb))
     DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::General, "Unsubscribed from the %s updates", buffLogicalName);
 
-  if (!buffer.Initialize(SharedMemoryPlugin::msDedicatedServerMapGlobally)) {
+  // Extended buffer is always mapped in the regular layout, because that's where clients find out about the triple buffered ones.
+  auto const tripleBuffered = sb != SubscribedBuffer::All
+    && Utils::IsFlagOn(SharedMemoryPlugin::msTripleBufferedBuffersMask, sb);
+
+  // Extended buffer is updated along with Scoring, so clients can wait on that.
+  auto const notifyUpdates = sb != SubscribedBuffer::All
+    && Utils::IsFlagOn(SharedMemoryPlugin::msUpdateNotificationBuffersMask, sb);
+
+  // Same as the triple buffered layout, clients need the regular Extended layout to find out about the isolated ones.
+  auto const cacheLineIsolated = sb != SubscribedBuffer::All
+    && Utils::IsFlagOn(SharedMemoryPlugin::msCacheLineIsolatedBuffersMask, sb);
+
+  // Large pages do not change the layout, but Extended is small enough for it not to matter.
+  auto const largePages = sb != SubscribedBuffer::All
+    && Utils::IsFlagOn(SharedMemoryPlugin::msLargePagesBuffersMask, sb);
+
+  if (!buffer.Initialize(SharedMemoryPlugin::msDedicatedServerMapGlobally, tripleBuffered, notifyUpdates, cacheLineIsolated, largePages)) {
     DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "Failed to initialize %s mapping", buffLogicalName);
     return false;
   }
 
-  auto const size = static_cast<int>(sizeof(BuffT::BufferType) + sizeof(rF2MappedBufferVersionBlock));
-  DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::General, "Size of the %s buffer: %d bytes.", buffLogicalName, size);
+  // Report what we actually got, so that the effect can be measured.
+  if (buffer.IsLargePages())
+    mExtStateTracker.mExtended.mLargePagesBuffersMask |= static_cast<long>(sb);
+
+  auto const size = static_cast<int>(buffer.GetMappedSize());
+  DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::General, "Size of the %s buffer: %d bytes.%s%s%s%s", buffLogicalName, size,
+    buffer.IsTripleBuffered() ? "  Triple buffered." : "", buffer.IsUpdateNotified() ? "  Update notification on." : "",
+    buffer.IsCacheLineIsolated() ? "  Cache line isolated." : "", buffer.IsLargePages() ? "  Large pages." : "");
 
   return true;
 }
@@ -896,6 +1647,9 @@ void SharedMemoryPlugin::UpdateScoring(ScoringInfoV01 const& info)
   if (mLastScoringUpdateET > mLastTelemetryUpdateET)
     DEBUG_MSG(DebugLevel::Warnings, DebugSource::General, "Scoring update is ahead of telemetry.");
 
+  // Compares with the previous Scoring update, so has to happen before it is overwritten.
+  EventJournalUpdate(info);
+
   mScoring.BeginUpdate();
 
   memcpy(&(mScoring.mpWriteBuff->mScoringInfo), &info, sizeof(rF2ScoringInfo));
@@ -903,13 +1657,29 @@ void SharedMemoryPlugin::UpdateScoring(ScoringInfoV01 const& info)
   if (info.mNumVehicles >= rF2MappedBufferHeader::MAX_MAPPED_VEHICLES)
     DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "Scoring exceeded maximum of allowed mapped vehicles.");
 
+  memset(mScoring.mpWriteBuff->mVehicleChangedBits, 0, sizeof(mScoring.mpWriteBuff->mVehicleChangedBits));
+
   auto const numScoringVehicles = min(info.mNumVehicles, rF2MappedBufferHeader::MAX_MAPPED_VEHICLES);
-  for (int i = 0; i < numScoringVehicles; ++i)
+  auto const prevScoring = mScoring.GetPublishedBuff();
+  mPlayerTelemetryID = -1L;
+  for (int i = 0; i < numScoringVehicles; ++i) {
+    if (info.mVehicle[i].mIsPlayer)
+      mPlayerTelemetryID = info.mVehicle[i].mID;
+
+    if (memcmp(&(prevScoring->mVehicles[i]), &(info.mVehicle[i]), sizeof(rF2VehicleScoring)) != 0)
+      mScoring.mpWriteBuff->mVehicleChangedBits[i / 8] |= static_cast<unsigned char>(1u << (i % 8));
+
     memcpy(&(mScoring.mpWriteBuff->mVehicles[i]), &(info.mVehicle[i]), sizeof(rF2VehicleScoring));
+  }
 
   mScoring.mpWriteBuff->mBytesUpdatedHint = static_cast<int>(offsetof(rF2Scoring, mVehicles[numScoringVehicles]));
 
-  mScoring.EndUpdate();
+  BuildVehicleIDIndex(mScoring.mpWriteBuff->mVehicleIDIndex, mScoring.mpWriteBuff->mVehicles, numScoringVehicles);
+  BuildPlaceOrder(*mScoring.mpWriteBuff, numScoringVehicles);
+
+  mScoring.EndUpdate(info.mCurrentET);
+
+  DerivedTimingUpdate(*mScoring.GetPublishedBuff());
 
   //
   // Piggyback on the ::UpdateScoring callback to perform operations that depend on scoring updates
@@ -921,106 +1691,481 @@ void SharedMemoryPlugin::UpdateScoring(ScoringInfoV01 const& info)
   ReadWeatherControl();
   ReadRulesControl();
   ReadPluginControl();
+  ReadTelemetryProjectionControl();
+  ReadReaderRegistry();
 
   // Update extended state.
   mExtStateTracker.ProcessScoringUpdate(info);
 
-  mExtended.BeginUpdate();
-  memcpy(mExtended.mpWriteBuff, &(mExtStateTracker.mExtended), sizeof(rF2Extended));
-  mExtended.EndUpdate();
+  ExtendedUpdate(static_cast<unsigned long>(rF2ExtendedSection::Damage) | static_cast<unsigned long>(rF2ExtendedSection::PluginState));
+
+  StatisticsUpdate();
 }
 
 
-void SharedMemoryPlugin::ReadDMROnScoringUpdate(ScoringInfoV01 const& info)
+// Returns mVehicles index of the mID in the update index was built for, or -1 if mID is not there.
+static long FindVehicleIndex(rF2VehicleIDIndex const& index, long id)
 {
-  if (SharedMemoryPlugin::msDirectMemoryAccessRequested) {
-    auto const LSIVisible = info.mYellowFlagState != 0 || info.mGamePhase == static_cast<unsigned char>(rF2GamePhase::Formation);
-    if (!mDMR.Read(mExtStateTracker.mExtended)
-      || (LSIVisible && !mDMR.ReadOnLSIVisible(mExtStateTracker.mExtended))) {  // Read on FCY or Formation lap.
-      DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "DMA read failed, disabling.");
+  id = max(id, 0L);
 
-      // Disable DMA on failure.
-      SharedMemoryPlugin::msDirectMemoryAccessRequested = false;
-      mExtStateTracker.mExtended.mDirectMemoryAccessEnabled = false;
-      // Extended flip will happen in ScoringUpdate.
-    }
-    else {  // Read succeeded.
-      if (mLastUpdateLSIWasVisible && !LSIVisible)
-        mDMR.ClearLSIValues(mExtStateTracker.mExtended);  // Clear LSI Values on LSI going away.
+  auto slot = id % rF2VehicleIDIndex::NUM_SLOTS;
+  for (int probe = 0; probe < rF2VehicleIDIndex::NUM_SLOTS; ++probe) {
+    if (index.mIDs[slot] == id)
+      return index.mVehicleIndices[slot];
 
-      mLastUpdateLSIWasVisible = LSIVisible;
-    }
+    if (index.mIDs[slot] == -1L)
+      return -1L;
+
+    slot = (slot + 1L) % rF2VehicleIDIndex::NUM_SLOTS;
   }
+
+  return -1L;
 }
 
 
-void SharedMemoryPlugin::ReadHWControl()
+void SharedMemoryPlugin::EventJournalUpdate(ScoringInfoV01 const& info)
 {
-  if (!mIsMapped
-    || !mExtStateTracker.mExtended.mHWControlInputEnabled)
+  if (Utils::IsFlagOn(SharedMemoryPlugin::msUnsubscribedBuffersMask, SubscribedBuffer::EventJournal)
+    || IsBufferSuspended(SubscribedBuffer::EventJournal))
     return;
 
-  static auto const BOOST_COUNTER_THRESHOULD_END = 500 / 20;  // 500ms boost.
-
-  // Control the rate of reads.
-  auto const needsBoost = ++mHWControlRequestBoostCounter < BOOST_COUNTER_THRESHOULD_END;
-  ++mHWControlRequestReadCounter;
-  if (!needsBoost
-    && (mHWControlRequestReadCounter % 10) != 0) // Normal 200ms poll (this function is called at 20ms update rate))
-    return;  // Skip read attempt.
+  auto const et = info.mCurrentET;
+  auto updateBegun = false;
 
-  // Read input buffers.
-  if (mHWControl.ReadUpdate()) {
-    if (mHWControl.mReadBuff.mLayoutVersion != rF2HWControl::SUPPORTED_LAYOUT_VERSION) {
-      DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "HWControl: unsupported input buffer layout version: %ld.  Disabling.", mHWControl.mReadBuff.mLayoutVersion);
+  // Session events.
+  auto& ss = mEventJournalSessionState;
+  if (ss.mValid) {
+    if (info.mSession != ss.mSession)
+      EventJournalAppend(rF2EventType::SessionChanged, et, -1L, -1L, ss.mSession, info.mSession, updateBegun);
 
-      mExtStateTracker.mExtended.mHWControlInputEnabled = false;
+    if (info.mGamePhase != ss.mGamePhase)
+      EventJournalAppend(rF2EventType::GamePhaseChanged, et, -1L, -1L, ss.mGamePhase, info.mGamePhase, updateBegun);
 
-      mExtended.BeginUpdate();
-      memcpy(mExtended.mpWriteBuff, &(mExtStateTracker.mExtended), sizeof(rF2Extended));
-      mExtended.EndUpdate();
+    if (info.mYellowFlagState != ss.mYellowFlagState)
+      EventJournalAppend(rF2EventType::YellowFlagStateChanged, et, -1L, -1L, ss.mYellowFlagState, info.mYellowFlagState, updateBegun);
 
-      return;
+    for (int s = 0; s < 3; ++s) {
+      if (info.mSectorFlag[s] != ss.mSectorFlags[s])
+        EventJournalAppend(rF2EventType::SectorFlagChanged, et, -1L, s, ss.mSectorFlags[s], info.mSectorFlag[s], updateBegun);
     }
+  }
 
-    mHWControlInputRequestReceived = true;
-    mHWControlRequestBoostCounter = 0;  // Boost refresh for the next 500ms.
-
-    if (Utils::IsFlagOn(SharedMemoryPlugin::msDebugOutputLevel, DebugLevel::DevInfo)) {
-      DEBUG_MSG(DebugLevel::DevInfo, DebugSource::HWControlInput, "HWControl: received:  '%s'  %1.1f   boosted: '%s'", 
-        mHWControl.mReadBuff.mControlName, mHWControl.mReadBuff.mfRetVal, 
-        needsBoost ? "True" : "False");
+  ss.mValid = true;
+  ss.mSession = info.mSession;
+  ss.mGamePhase = info.mGamePhase;
+  ss.mYellowFlagState = info.mYellowFlagState;
+  memcpy(ss.mSectorFlags, info.mSectorFlag, sizeof(ss.mSectorFlags));
+
+  // Vehicle events.  Previous update is empty after session restart, so vehicles of the first update are not compared.
+  auto const& prevScoring = *mScoring.GetPublishedBuff();
+  auto const numPrevVehicles = min(prevScoring.mScoringInfo.mNumVehicles, rF2MappedBufferHeader::MAX_MAPPED_VEHICLES);
+  auto const numVehicles = min(info.mNumVehicles, rF2MappedBufferHeader::MAX_MAPPED_VEHICLES);
+  if (numPrevVehicles > 0L) {
+    for (int i = 0; i < numVehicles; ++i) {
+      auto const& vs = info.mVehicle[i];
+      auto const prevIndex = FindVehicleIndex(prevScoring.mVehicleIDIndex, vs.mID);
+      if (prevIndex < 0L || prevIndex >= numPrevVehicles)
+        continue;  // Joined since the previous update.
+
+      auto const& prev = prevScoring.mVehicles[prevIndex];
+      if (vs.mInPits != prev.mInPits)
+        EventJournalAppend(vs.mInPits ? rF2EventType::PitEntered : rF2EventType::PitExited, et, vs.mID, i, prev.mInPits, vs.mInPits, updateBegun);
+
+      if (vs.mPitState != prev.mPitState)
+        EventJournalAppend(rF2EventType::PitStateChanged, et, vs.mID, i, prev.mPitState, vs.mPitState, updateBegun);
+
+      if (vs.mFlag != prev.mFlag)
+        EventJournalAppend(rF2EventType::FlagChanged, et, vs.mID, i, prev.mFlag, vs.mFlag, updateBegun);
+
+      if (vs.mTotalLaps > prev.mTotalLaps)
+        EventJournalAppend(rF2EventType::LapCompleted, et, vs.mID, i, prev.mTotalLaps, vs.mTotalLaps, updateBegun);
+
+      if (vs.mNumPenalties != prev.mNumPenalties)
+        EventJournalAppend(rF2EventType::PenaltiesChanged, et, vs.mID, i, prev.mNumPenalties, vs.mNumPenalties, updateBegun);
+
+      if (vs.mFinishStatus != prev.mFinishStatus)
+        EventJournalAppend(rF2EventType::FinishStatusChanged, et, vs.mID, i, prev.mFinishStatus, vs.mFinishStatus, updateBegun);
     }
   }
 
-  // Guard against bad inputs, even though it is not plugin's job to do that really.
-  if (mHWControlRequestBoostCounter >= BOOST_COUNTER_THRESHOULD_END
-    && mHWControlInputRequestReceived) {
-    mHWControlInputRequestReceived = false;
-    DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "Resetting mHWControlInputRequestReceived for input value: '%s'.  Bad input value?", mHWControl.mReadBuff.mControlName);
-  }
+  if (updateBegun)
+    mEventJournal.EndUpdate(et);
 }
 
 
-void SharedMemoryPlugin::ReadWeatherControl()
+// Begins buffer update on the first event appended, so that Scoring updates without transitions do not bump the version.
+void SharedMemoryPlugin::EventJournalAppend(rF2EventType type, double elapsedTime, long id, long index, long oldValue, long newValue, bool& updateBegun)
 {
-  if (!mIsMapped
-    || !mExtStateTracker.mExtended.mWeatherControlInputEnabled)
-    return;
+  if (!updateBegun) {
+    mEventJournal.BeginUpdate();
+    updateBegun = true;
+  }
 
-  // Read input buffers.
-  if (mWeatherControl.ReadUpdate()) {
-    if (mWeatherControl.mReadBuff.mLayoutVersion != rF2WeatherControl::SUPPORTED_LAYOUT_VERSION) {
-      DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "Weather control: unsupported input buffer layout version: %ld.  Disabling.", mWeatherControl.mReadBuff.mLayoutVersion);
+  auto& journal = *mEventJournal.mpWriteBuff;
+  auto const sequence = journal.mLastSequence + 1uL;
+  auto& event = journal.mEvents[sequence % rF2EventJournal::MAX_EVENTS];
 
-      mExtStateTracker.mExtended.mWeatherControlInputEnabled = false;
-      // Extended flip will happen in ScoringUpdate.
-      return;
-    }
+  // Invalidate the slot before overwriting it, so that reader lapped by the plugin can detect that.
+  MappedBufferPlatform::AtomicExchange(&event.mSequence, 0uL);
 
-    DEBUG_MSG(DebugLevel::DevInfo, DebugSource::WeatherControlInput, "Weather control input received.");
-    mWeatherControlInputRequestReceived = true;
-  }
+  event.mType = static_cast<long>(type);
+  event.mElapsedTime = elapsedTime;
+  event.mID = id;
+  event.mIndex = index;
+  event.mOldValue = oldValue;
+  event.mNewValue = newValue;
+
+  // Publish the event.
+  MappedBufferPlatform::AtomicExchange(&event.mSequence, sequence);
+  MappedBufferPlatform::AtomicExchange(&journal.mLastSequence, sequence);
+}
+
+
+// Scoring updates arrive at 5FPS, so this allows for one late update.
+static double const MAX_TIMING_INTERPOLATION_SECONDS = 0.4;
+
+// Returns lapDist wrapped to [0, trackLength).
+static double WrapLapDist(double lapDist, double trackLength)
+{
+  lapDist = fmod(lapDist, trackLength);
+  return lapDist < 0.0 ? lapDist + trackLength : lapDist;
+}
+
+
+// Caches standings and on-track state of the Scoring update, DerivedTimingPublish publishes them.
+void SharedMemoryPlugin::DerivedTimingUpdate(rF2Scoring const& scoring)
+{
+  if (Utils::IsFlagOn(SharedMemoryPlugin::msUnsubscribedBuffersMask, SubscribedBuffer::DerivedTiming)
+    || IsBufferSuspended(SubscribedBuffer::DerivedTiming))
+    return;
+
+  auto const& si = scoring.mScoringInfo;
+  auto const numVehicles = min(si.mNumVehicles, rF2MappedBufferHeader::MAX_MAPPED_VEHICLES);
+  auto const trackLength = si.mLapDist;
+
+  // Standings, walked in place order.  Classes are identified by the mVehicles index of their leader.
+  long classLeaders[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];
+  long classLast[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];
+  unsigned char classCounts[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];
+  auto numClasses = 0L;
+  for (int p = 0; p < numVehicles; ++p) {
+    auto const i = scoring.mPlaceOrder[p];
+    auto const& vs = scoring.mVehicles[i];
+    auto& vt = mDerivedTimingStandings[i];
+
+    vt.mID = vs.mID;
+    vt.mPlace = vs.mPlace;
+    vt.mTimeBehindLeader = vs.mTimeBehindLeader;
+    vt.mLapsBehindLeader = vs.mLapsBehindLeader;
+    vt.mTimeBehindNext = vs.mTimeBehindNext;
+    vt.mLapsBehindNext = vs.mLapsBehindNext;
+
+    auto c = 0L;
+    while (c < numClasses
+      && strncmp(scoring.mVehicles[classLeaders[c]].mVehicleClass, vs.mVehicleClass, sizeof(vs.mVehicleClass)) != 0)
+      ++c;
+
+    if (c == numClasses) {
+      classLeaders[c] = i;
+      classLast[c] = -1L;
+      classCounts[c] = 0;
+      ++numClasses;
+    }
+
+    auto const& classLeader = scoring.mVehicles[classLeaders[c]];
+    vt.mClassPlace = ++classCounts[c];
+    vt.mClassLeaderID = classLeader.mID;
+    vt.mTimeBehindClassLeader = vs.mTimeBehindLeader - classLeader.mTimeBehindLeader;
+    vt.mLapsBehindClassLeader = vs.mLapsBehindLeader - classLeader.mLapsBehindLeader;
+
+    if (classLast[c] == -1L) {
+      vt.mClassNextID = -1L;
+      vt.mTimeBehindClassNext = 0.0;
+      vt.mLapsBehindClassNext = 0L;
+    }
+    else {
+      auto const& classNext = scoring.mVehicles[classLast[c]];
+      vt.mClassNextID = classNext.mID;
+      vt.mTimeBehindClassNext = vs.mTimeBehindLeader - classNext.mTimeBehindLeader;
+      vt.mLapsBehindClassNext = vs.mLapsBehindLeader - classNext.mLapsBehindLeader;
+    }
+
+    classLast[c] = i;
+  }
+
+  for (int i = 0; i < numVehicles; ++i) {
+    auto const& vs = scoring.mVehicles[i];
+    auto& source = mDerivedTimingTrackSources[i];
+
+    source.mLapDist = vs.mLapDist;
+    source.mSpeed = sqrt(Dot(vs.mLocalVel, vs.mLocalVel));
+    // Average lap speed is steadier than the current speed, which drops in every corner.
+    source.mGapSpeed = vs.mEstimatedLapTime > 0.0 && trackLength > 0.0 ? trackLength / vs.mEstimatedLapTime : source.mSpeed;
+    source.mOnTrack = !vs.mInGarageStall
+      && vs.mFinishStatus != static_cast<signed char>(rF2FinishStatus::Dnf)
+      && vs.mFinishStatus != static_cast<signed char>(rF2FinishStatus::Dq);
+  }
+
+  mDerivedTimingNumVehicles = numVehicles;
+  mDerivedTimingScoringET = si.mCurrentET;
+  mDerivedTimingTrackLength = trackLength;
+
+  DerivedTimingPublish();
+}
+
+
+// Publishes standings of the last Scoring update, and on-track positions, neighbours and gaps advanced to the last telemetry
+// ET.  Invoked on each Scoring update, and on each completed telemetry frame.
+void SharedMemoryPlugin::DerivedTimingPublish()
+{
+  if (Utils::IsFlagOn(SharedMemoryPlugin::msUnsubscribedBuffersMask, SubscribedBuffer::DerivedTiming)
+    || IsBufferSuspended(SubscribedBuffer::DerivedTiming)
+    || mDerivedTimingScoringET < 0.0)
+    return;
+
+  auto const numVehicles = mDerivedTimingNumVehicles;
+  auto const trackLength = mDerivedTimingTrackLength;
+
+  // Scoring lags telemetry, so advance on-track positions to the last telemetry ET.
+  auto const dt = min(max(mLastTelemetryUpdateET - mDerivedTimingScoringET, 0.0), MAX_TIMING_INTERPOLATION_SECONDS);
+
+  mDerivedTiming.BeginUpdate();
+
+  auto& timing = *mDerivedTiming.mpWriteBuff;
+  timing.mScoringElapsedTime = mDerivedTimingScoringET;
+  timing.mElapsedTime = mDerivedTimingScoringET + dt;
+  timing.mNumVehicles = numVehicles;
+
+  memcpy(timing.mVehicles, mDerivedTimingStandings, numVehicles * sizeof(rF2VehicleDerivedTiming));
+
+  // On-track neighbours.  Insertion sort by interpolated lap distance, there are rarely more than a few dozen vehicles.
+  unsigned char trackOrder[rF2MappedBufferHeader::MAX_MAPPED_VEHICLES];
+  auto numOnTrack = 0;
+  for (int i = 0; i < numVehicles; ++i) {
+    auto const& source = mDerivedTimingTrackSources[i];
+    auto& vt = timing.mVehicles[i];
+
+    vt.mTrackAheadID = -1L;
+    vt.mTrackGapAhead = -1.0;
+    vt.mTrackBehindID = -1L;
+    vt.mTrackGapBehind = -1.0;
+
+    if (trackLength <= 0.0) {
+      vt.mLapDist = source.mLapDist;
+      continue;
+    }
+
+    vt.mLapDist = WrapLapDist(source.mLapDist + source.mSpeed * dt, trackLength);
+
+    if (!source.mOnTrack)
+      continue;
+
+    auto j = numOnTrack++;
+    for (; j > 0 && timing.mVehicles[trackOrder[j - 1]].mLapDist > vt.mLapDist; --j)
+      trackOrder[j] = trackOrder[j - 1];
+
+    trackOrder[j] = static_cast<unsigned char>(i);
+  }
+
+  if (numOnTrack > 1) {
+    for (int k = 0; k < numOnTrack; ++k) {
+      auto const& source = mDerivedTimingTrackSources[trackOrder[k]];
+      auto& vt = timing.mVehicles[trackOrder[k]];
+      auto& ahead = timing.mVehicles[trackOrder[(k + 1) % numOnTrack]];
+
+      auto const distance = WrapLapDist(ahead.mLapDist - vt.mLapDist, trackLength);
+
+      vt.mTrackAheadID = ahead.mID;
+      vt.mTrackGapAhead = source.mGapSpeed > 0.0 ? distance / source.mGapSpeed : -1.0;
+      ahead.mTrackBehindID = vt.mID;
+      ahead.mTrackGapBehind = vt.mTrackGapAhead;
+    }
+  }
+
+  timing.mBytesUpdatedHint = static_cast<int>(offsetof(rF2DerivedTiming, mVehicles[numVehicles]));
+
+  mDerivedTiming.EndUpdate(timing.mElapsedTime);
+}
+
+
+void SharedMemoryPlugin::ReadDMROnScoringUpdate(ScoringInfoV01 const& info)
+{
+  if (SharedMemoryPlugin::msDirectMemoryAccessRequested) {
+    auto const LSIVisible = info.mYellowFlagState != 0 || info.mGamePhase == static_cast<unsigned char>(rF2GamePhase::Formation);
+    if (!mDMR.Read(mExtStateTracker.mExtended)
+      || (LSIVisible && !mDMR.ReadOnLSIVisible(mExtStateTracker.mExtended))) {  // Read on FCY or Formation lap.
+      DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "DMA read failed, disabling.");
+
+      // Disable DMA on failure.
+      SharedMemoryPlugin::msDirectMemoryAccessRequested = false;
+      mExtStateTracker.mExtended.mDirectMemoryAccessEnabled = false;
+      // Extended flip will happen in ScoringUpdate.
+    }
+    else {  // Read succeeded.
+      if (mLastUpdateLSIWasVisible && !LSIVisible)
+        mDMR.ClearLSIValues(mExtStateTracker.mExtended);  // Clear LSI Values on LSI going away.
+
+      mLastUpdateLSIWasVisible = LSIVisible;
+    }
+  }
+}
+
+
+void SharedMemoryPlugin::ReadHWControl()
+{
+  if (!mIsMapped
+    || !mExtStateTracker.mExtended.mHWControlInputEnabled)
+    return;
+
+  static auto const BOOST_COUNTER_THRESHOULD_END = 500 / 20;  // 500ms boost.
+
+  // Control the rate of reads.
+  auto const needsBoost = ++mHWControlRequestBoostCounter < BOOST_COUNTER_THRESHOULD_END;
+  ++mHWControlRequestReadCounter;
+  if (!needsBoost
+    && (mHWControlRequestReadCounter % 10) != 0) // Normal 200ms poll (this function is called at 20ms update rate))
+    return;  // Skip read attempt.
+
+  ReadHWControlBuffer(needsBoost);
+
+  // Guard against bad inputs, even though it is not plugin's job to do that really.
+  if (mHWControlRequestBoostCounter >= BOOST_COUNTER_THRESHOULD_END
+    && mHWControlInputRequestReceived
+    && !mHWControlCommandQueued) {
+    mHWControlInputRequestReceived = false;
+    DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "Resetting mHWControlInputRequestReceived for input value: '%s'.  Bad input value?", mHWControlCommand.mControlName);
+  }
+}
+
+
+void SharedMemoryPlugin::ReadHWControlBuffer(bool boosted)
+{
+  if (mHWControl.ReadUpdate()) {
+    // Layout version 1 is still supported.
+    if (mHWControl.mReadBuff.mLayoutVersion != 1L
+      && mHWControl.mReadBuff.mLayoutVersion != rF2HWControl::SUPPORTED_LAYOUT_VERSION) {
+      DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "HWControl: unsupported input buffer layout version: %ld.  Disabling.", mHWControl.mReadBuff.mLayoutVersion);
+
+      mExtStateTracker.mExtended.mHWControlInputEnabled = false;
+
+      ExtendedUpdate(static_cast<unsigned long>(rF2ExtendedSection::PluginState));
+
+      return;
+    }
+
+    if (mHWControl.mReadBuff.mLayoutVersion == rF2HWControl::SUPPORTED_LAYOUT_VERSION) {
+      // Commands come through the queue from now on, see ReadHWControlQueue.
+      if (!mHWControlQueueEnabled) {
+        DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::HWControlInput, "HWControl: command queue enabled.");
+        mHWControlQueueEnabled = true;
+      }
+
+      return;
+    }
+
+    // Single command overrides the queued one, which stays in the queue.
+    memcpy(mHWControlCommand.mControlName, mHWControl.mReadBuff.mControlName, sizeof(mHWControlCommand.mControlName));
+    mHWControlCommand.mfRetVal = mHWControl.mReadBuff.mfRetVal;
+    mHWControlCommandIndex = FindHWControl(mHWControlCommand.mControlName);
+    mHWControlCommandQueued = false;
+
+    mHWControlInputRequestReceived = true;
+    mHWControlRequestBoostCounter = 0;  // Boost refresh for the next 500ms.
+
+    if (Utils::IsFlagOn(SharedMemoryPlugin::msDebugOutputLevel, DebugLevel::DevInfo)) {
+      DEBUG_MSG(DebugLevel::DevInfo, DebugSource::HWControlInput, "HWControl: received:  '%s'  %1.1f   boosted: '%s'", 
+        mHWControlCommand.mControlName, mHWControlCommand.mfRetVal,
+        boosted ? "True" : "False");
+    }
+  }
+}
+
+
+// Invoked once per frame, from HasHardwareInputs.
+void SharedMemoryPlugin::ReadHWControlQueue()
+{
+  if (!mIsMapped)
+    return;
+
+  static auto const STALL_COUNTER_THRESHOLD_END = 50;  // ~500ms at 100FPS.
+
+  if (mHWControlCommandQueued) {
+    // Guard against bad inputs, otherwise single bad command would block the queue.
+    if (++mHWControlQueueStallCounter < STALL_COUNTER_THRESHOLD_END)
+      return;
+
+    DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "Dropping queued HWControl input value: '%s'.  Bad input value?", mHWControlCommand.mControlName);
+    mHWControlInputRequestReceived = false;
+    PopQueuedHWControlCommand();
+  }
+
+  // Single command has priority.
+  if (!mHWControlInputRequestReceived)
+    LoadQueuedHWControlCommand();
+}
+
+
+void SharedMemoryPlugin::LoadQueuedHWControlCommand()
+{
+  auto& hwc = *mHWControl.mpWriteBuff;
+  auto const readIndex = hwc.mQueueReadIndex;
+  auto const writeIndex = MappedBufferPlatform::AtomicLoad(&(hwc.mQueueWriteIndex));
+  if (writeIndex == readIndex)
+    return;  // Empty.
+
+  if (writeIndex - readIndex > rF2HWControl::MAX_QUEUED_COMMANDS) {
+    DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "HWControl: queue overrun.  Read index: %lu  write index: %lu.  Dropping queued commands.", readIndex, writeIndex);
+    MappedBufferPlatform::AtomicExchange(&(hwc.mQueueReadIndex), writeIndex);
+    return;
+  }
+
+  auto const& command = hwc.mQueue[readIndex % rF2HWControl::MAX_QUEUED_COMMANDS];
+  memcpy(&mHWControlCommand, &command, sizeof(rF2HWControlCommand));
+  mHWControlCommand.mControlName[rF2HWControl::MAX_HWCONTROL_NAME_LEN - 1] = '\0';
+  mHWControlCommandIndex = FindHWControl(mHWControlCommand.mControlName);
+
+  mHWControlCommandQueued = true;
+  mHWControlQueueStallCounter = 0;
+  mHWControlInputRequestReceived = true;
+
+  if (Utils::IsFlagOn(SharedMemoryPlugin::msDebugOutputLevel, DebugLevel::DevInfo)) {
+    DEBUG_MSG(DebugLevel::DevInfo, DebugSource::HWControlInput, "HWControl: dequeued:  '%s'  %1.1f   index: %lu  queued: %lu",
+      mHWControlCommand.mControlName, mHWControlCommand.mfRetVal, readIndex, writeIndex - readIndex);
+  }
+}
+
+
+void SharedMemoryPlugin::PopQueuedHWControlCommand()
+{
+  assert(mHWControlCommandQueued);
+
+  // Releases the slot to the client.
+  auto& hwc = *mHWControl.mpWriteBuff;
+  MappedBufferPlatform::AtomicExchange(&(hwc.mQueueReadIndex), hwc.mQueueReadIndex + 1uL);
+
+  mHWControlCommandQueued = false;
+}
+
+
+void SharedMemoryPlugin::ReadWeatherControl()
+{
+  if (!mIsMapped
+    || !mExtStateTracker.mExtended.mWeatherControlInputEnabled)
+    return;
+
+  // Read input buffers.
+  if (mWeatherControl.ReadUpdate()) {
+    if (mWeatherControl.mReadBuff.mLayoutVersion != rF2WeatherControl::SUPPORTED_LAYOUT_VERSION) {
+      DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "Weather control: unsupported input buffer layout version: %ld.  Disabling.", mWeatherControl.mReadBuff.mLayoutVersion);
+
+      mExtStateTracker.mExtended.mWeatherControlInputEnabled = false;
+      // Extended flip will happen in ScoringUpdate.
+      return;
+    }
+
+    DEBUG_MSG(DebugLevel::DevInfo, DebugSource::WeatherControlInput, "Weather control input received.");
+    mWeatherControlInputRequestReceived = true;
+  }
 }
 
 
@@ -1098,6 +2243,13 @@ void SharedMemoryPlugin::ReadPluginControl()
     DynamicallySubscribeToBuffer(SubscribedBuffer::Graphics, rebm, "Graphics");
     DynamicallySubscribeToBuffer(SubscribedBuffer::PitInfo, rebm, "PitInfo");
     DynamicallySubscribeToBuffer(SubscribedBuffer::Weather, rebm, "Weather");
+    DynamicallySubscribeToBuffer(SubscribedBuffer::TelemetryHistory, rebm, "Telemetry History");
+    DynamicallySubscribeToBuffer(SubscribedBuffer::TelemetryLite, rebm, "Telemetry Lite");
+    DynamicallySubscribeToBuffer(SubscribedBuffer::TelemetryProjections, rebm, "Telemetry Projections");
+    DynamicallySubscribeToBuffer(SubscribedBuffer::PlayerTelemetry, rebm, "Player Telemetry");
+    DynamicallySubscribeToBuffer(SubscribedBuffer::Extrapolation, rebm, "Extrapolation");
+    DynamicallySubscribeToBuffer(SubscribedBuffer::EventJournal, rebm, "Event Journal");
+    DynamicallySubscribeToBuffer(SubscribedBuffer::DerivedTiming, rebm, "Derived Timing");
 
     mExtStateTracker.mExtended.mUnsubscribedBuffersMask = SharedMemoryPlugin::msUnsubscribedBuffersMask;
 
@@ -1121,10 +2273,202 @@ void SharedMemoryPlugin::ReadPluginControl()
 }
 
 
+void SharedMemoryPlugin::ReadTelemetryProjectionControl()
+{
+  if (!mIsMapped)
+    return;
+
+  // Read the input buffer.
+  if (mTelemetryProjectionControl.ReadUpdate()) {
+    auto const& tpc = mTelemetryProjectionControl.mReadBuff;
+    if (tpc.mLayoutVersion != rF2TelemetryProjectionControl::SUPPORTED_LAYOUT_VERSION) {
+      DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "Telemetry projection control: unsupported input buffer layout version: %ld.  Ignoring.", tpc.mLayoutVersion);
+      return;
+    }
+
+    if (tpc.mProjectionIndex < 0L || tpc.mProjectionIndex >= rF2TelemetryProjections::MAX_PROJECTIONS) {
+      DEBUG_MSG(DebugLevel::Errors, DebugSource::General, "Telemetry projection control: invalid projection index: %ld.  Ignoring.", tpc.mProjectionIndex);
+      return;
+    }
+
+    auto const mask = tpc.mFieldGroupsMask & static_cast<unsigned long>(rF2TelemetryFieldGroup::All);
+    DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::General, "Telemetry projection control input received.  Projection: %ld  field groups mask: %lu",
+      tpc.mProjectionIndex, mask);
+
+    if (mask != 0uL && Utils::IsFlagOn(SharedMemoryPlugin::msUnsubscribedBuffersMask, SubscribedBuffer::TelemetryProjections))
+      DEBUG_MSG(DebugLevel::Warnings, DebugSource::General, "Telemetry Projections buffer is unsubscribed from.  Projection will be published once it is subscribed to.");
+
+    // Applied on the next completed Telemetry frame.
+    mTelemetryProjectionMasks[tpc.mProjectionIndex] = mask;
+  }
+}
+
+
+void SharedMemoryPlugin::ReadReaderRegistry()
+{
+  if (!mIsMapped
+    || SharedMemoryPlugin::msSuspendIdleBuffersMask == 0L)
+    return;
+
+  auto const ticksNow = TicksNow();
+  auto& registry = *mReaderRegistry.mpWriteBuff;
+
+  auto liveReadersMask = 0L;
+  for (int i = 0; i < rF2ReaderRegistry::MAX_READERS; ++i) {
+    auto& reader = registry.mReaders[i];
+    auto const processId = MappedBufferPlatform::AtomicLoad(&reader.mProcessId);
+    if (processId == 0uL) {
+      mReaderLastHeartbeatTicks[i] = 0.0;
+      continue;
+    }
+
+    auto const heartbeat = MappedBufferPlatform::AtomicLoad(&reader.mHeartbeat);
+    if (heartbeat != mReaderLastHeartbeats[i] || mReaderLastHeartbeatTicks[i] == 0.0) {
+      mReaderLastHeartbeats[i] = heartbeat;
+      mReaderLastHeartbeatTicks[i] = ticksNow;
+    }
+
+    auto const millisSinceHeartbeat = (ticksNow - mReaderLastHeartbeatTicks[i]) / MICROSECONDS_IN_MILLISECOND;
+    if (millisSinceHeartbeat <= rF2ReaderRegistry::HEARTBEAT_TIMEOUT_MS)
+      liveReadersMask |= reader.mBuffersMask;
+    else if (millisSinceHeartbeat > rF2ReaderRegistry::RECLAIM_TIMEOUT_MS) {
+      // Client most likely exited without releasing the slot.  Free it, unless it was re-claimed in the meantime.
+      if (MappedBufferPlatform::AtomicCompareExchange(&reader.mProcessId, 0uL, processId) == processId) {
+        DEBUG_MSG(DebugLevel::DevInfo, DebugSource::General, "Reader registry: reclaimed slot: %d  of process: %lu", i, processId);
+        mReaderLastHeartbeatTicks[i] = 0.0;
+      }
+    }
+  }
+
+  auto const prevSuspended = mExtStateTracker.mExtended.mSuspendedBuffersMask;
+  auto const suspended = SharedMemoryPlugin::msSuspendIdleBuffersMask & ~liveReadersMask;
+  if (suspended == prevSuspended)
+    return;
+
+  // Pit menu is only published on change, so make sure resumed buffer gets the current state.
+  if (Utils::IsFlagOn(prevSuspended, SubscribedBuffer::PitInfo)
+    && Utils::IsFlagOff(suspended, SubscribedBuffer::PitInfo)) {
+    mPitMenuLastCategoryIndex = -1L;
+    mPitMenuLastChoiceIndex = -1L;
+    mPitMenuLastNumChoices = -1L;
+  }
+
+  DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::General, "Updated suspended buffers mask: %ld", suspended);
+
+  // Extended flip will happen in ScoringUpdate.
+  mExtStateTracker.mExtended.mSuspendedBuffersMask = suspended;
+}
+
+
+void SharedMemoryPlugin::StatisticsUpdate()
+{
+  static_assert(static_cast<long>(SubscribedBuffer::All) < (1L << rF2Statistics::MAX_BUFFERS), "rF2Statistics::MAX_BUFFERS is too small.");
+
+  mStatistics.BeginUpdate();
+
+  auto& stats = *mStatistics.mpWriteBuff;
+  stats.mTimestampFrequency = MappedBufferPlatform::GetTimestampFrequency();
+
+  // Indexed by SubscribedBuffer flag bit.  ForceFeedback (4) and Graphics (5) are not versioned, so they have no statistics.
+  stats.mBuffers[0] = mTelemetry.GetStatistics();
+  stats.mBuffers[1] = mScoring.GetStatistics();
+  stats.mBuffers[2] = mRules.GetStatistics();
+  stats.mBuffers[3] = mMultiRules.GetStatistics();
+  stats.mBuffers[6] = mPitInfo.GetStatistics();
+  stats.mBuffers[7] = mWeather.GetStatistics();
+  stats.mBuffers[8] = mTelemetryHistory.GetStatistics();
+  stats.mBuffers[9] = mTelemetryLite.GetStatistics();
+  stats.mBuffers[10] = mTelemetryProjections.GetStatistics();
+  stats.mBuffers[11] = mPlayerTelemetry.GetStatistics();
+  // Extrapolation statistics are written on the multimedia thread, retry if the copy was torn.
+  for (;;) {
+    auto const version = MappedBufferPlatform::AtomicLoad(&mExtrapolationStatisticsVersion);
+    if ((version & 1uL) != 0uL)
+      continue;
+
+    stats.mBuffers[12] = mExtrapolationStatistics;
+    if (MappedBufferPlatform::AtomicLoad(&mExtrapolationStatisticsVersion) == version)
+      break;
+  }
+  stats.mBuffers[13] = mEventJournal.GetStatistics();
+  stats.mBuffers[14] = mDerivedTiming.GetStatistics();
+
+  mStatistics.EndUpdate();
+}
+
+
+// Ranges of rF2Extended covered by each rF2ExtendedSection flag, in the flag order.
+static struct
+{
+  size_t mBegin;
+  size_t mEnd;
+} const EXTENDED_SECTION_RANGES[rF2Extended::NUM_SECTIONS] =
+{
+  { offsetof(rF2Extended, mVersion), offsetof(rF2Extended, mTrackedDamages) },                                  // Physics
+  { offsetof(rF2Extended, mTrackedDamages), offsetof(rF2Extended, mInRealtimeFC) },                             // Damage
+  { offsetof(rF2Extended, mInRealtimeFC), offsetof(rF2Extended, mSessionTransitionCapture) },                   // CallbackFlags
+  { offsetof(rF2Extended, mSessionTransitionCapture), offsetof(rF2Extended, mDisplayedMessageUpdateCapture) },  // SessionCapture
+  { offsetof(rF2Extended, mDisplayedMessageUpdateCapture), offsetof(rF2Extended, mSectionVersions) },           // PluginState
+  { offsetof(rF2Extended, mLastImpactSequence), sizeof(rF2Extended) }                                            // Impacts
+};
+
+
+void SharedMemoryPlugin::MarkExtendedSectionsUpdated(unsigned long sectionsMask)
+{
+  for (int s = 0; s < rF2Extended::NUM_SECTIONS; ++s) {
+    if ((sectionsMask & (1uL << s)) != 0uL)
+      ++mExtStateTracker.mExtended.mSectionVersions[s];
+  }
+}
+
+
+// Publishes rF2ExtendedSection flags in sectionsMask.  Sections not in the mask must not have changed since they were last published,
+// except for PluginState, which is published on each Scoring update.  Impacts recorded since the last publish go out with any update.
+// Extended is mapped with SubscribedBuffer::All, so it always uses the regular layout, and sections not written keep published values.
+void SharedMemoryPlugin::ExtendedUpdate(unsigned long sectionsMask)
+{
+  if (mExtStateTracker.HasUnpublishedImpacts())
+    sectionsMask |= static_cast<unsigned long>(rF2ExtendedSection::Impacts);
+
+  MarkExtendedSectionsUpdated(sectionsMask);
+
+  auto const& ext = mExtStateTracker.mExtended;
+
+  mExtended.BeginUpdate();
+
+  auto const pSrc = reinterpret_cast<char const*>(&ext);
+  auto const pDest = reinterpret_cast<char*>(mExtended.mpWriteBuff);
+  for (int s = 0; s < rF2Extended::NUM_SECTIONS; ++s) {
+    if ((sectionsMask & (1uL << s)) == 0uL)
+      continue;
+
+    if ((1uL << s) == static_cast<unsigned long>(rF2ExtendedSection::Damage)) {
+      // Damage array is large, but only a few entries change between updates.
+      mExtStateTracker.FlushDirtyDamageSlots(mExtended.mpWriteBuff);
+      continue;
+    }
+
+    if ((1uL << s) == static_cast<unsigned long>(rF2ExtendedSection::Impacts)) {
+      // Only impacts recorded since the last publish.
+      mExtStateTracker.FlushImpacts(mExtended.mpWriteBuff);
+      continue;
+    }
+
+    auto const& range = EXTENDED_SECTION_RANGES[s];
+    memcpy(pDest + range.mBegin, pSrc + range.mBegin, range.mEnd - range.mBegin);
+  }
+
+  memcpy(mExtended.mpWriteBuff->mSectionVersions, ext.mSectionVersions, sizeof(ext.mSectionVersions));
+
+  mExtended.EndUpdate();
+}
+
+
 // Invoked at ~400FPS.
 bool SharedMemoryPlugin::ForceFeedback(double& forceValue)
 {
-  if (Utils::IsFlagOn(SharedMemoryPlugin::msUnsubscribedBuffersMask, SubscribedBuffer::ForceFeedback) || !mIsMapped)
+  if (Utils::IsFlagOn(SharedMemoryPlugin::msUnsubscribedBuffersMask, SubscribedBuffer::ForceFeedback) || !mIsMapped
+    || IsBufferSuspended(SubscribedBuffer::ForceFeedback))
     return false;
 
   DEBUG_MSG(DebugLevel::Timing, DebugSource::ForceFeedback, "FORCE FEEDBACK - Updated");
@@ -1141,9 +2485,7 @@ void SharedMemoryPlugin::UpdateThreadState(long type, bool starting)
   (type == 0 ? mExtStateTracker.mExtended.mMultimediaThreadStarted : mExtStateTracker.mExtended.mSimulationThreadStarted)
     = starting;
 
-  mExtended.BeginUpdate();
-  memcpy(mExtended.mpWriteBuff, &(mExtStateTracker.mExtended), sizeof(rF2Extended));
-  mExtended.EndUpdate();
+  ExtendedUpdate(static_cast<unsigned long>(rF2ExtendedSection::CallbackFlags));
 }
 
 
@@ -1167,12 +2509,8 @@ void SharedMemoryPlugin::ThreadStopping(long type)
 }
 
 
-// Called roughly every 300ms.
-bool SharedMemoryPlugin::AccessTrackRules(TrackRulesV01& info)
+void SharedMemoryPlugin::RulesUpdate(TrackRulesV01 const& info)
 {
-  if (!mIsMapped)
-    return false;
-
   TraceBeginUpdate(mRules, mLastRulesUpdateMillis, "RULES");
 
   mRules.BeginUpdate();
@@ -1198,7 +2536,21 @@ bool SharedMemoryPlugin::AccessTrackRules(TrackRulesV01& info)
 
   mRules.mpWriteBuff->mBytesUpdatedHint = static_cast<int>(offsetof(rF2Rules, mParticipants[numRulesVehicles]));
 
-  mRules.EndUpdate();
+  mRules.EndUpdate(info.mCurrentET);
+}
+
+
+// Called roughly every 300ms.
+bool SharedMemoryPlugin::AccessTrackRules(TrackRulesV01& info)
+{
+  if (!mIsMapped)
+    return false;
+
+  if (!IsBufferSuspended(SubscribedBuffer::Rules))
+    RulesUpdate(info);
+
+  if (SharedMemoryPlugin::msEventDrivenInputBuffers)
+    ReadRulesControl();
 
   if (mRulesControlInputRequestReceived) {
     // Note: all experimental/WIP.
@@ -1285,15 +2637,14 @@ void SharedMemoryPlugin::SetPhysicsOptions(PhysicsOptionsV01& options)
 
   memcpy(&(mExtStateTracker.mExtended.mPhysics), &options, sizeof(rF2PhysicsOptions));
 
-  mExtended.BeginUpdate();
-  memcpy(mExtended.mpWriteBuff, &(mExtStateTracker.mExtended), sizeof(rF2Extended));
-  mExtended.EndUpdate();
+  ExtendedUpdate(static_cast<unsigned long>(rF2ExtendedSection::Physics));
 }
 
 
 bool SharedMemoryPlugin::AccessMultiSessionRules(MultiSessionRulesV01& info)
 {
-  if (!mIsMapped)
+  if (!mIsMapped
+    || IsBufferSuspended(SubscribedBuffer::MultiRules))
     return false;
 
   TraceBeginUpdate(mMultiRules, mLastMultiRulesUpdateMillis, "MULTI RULES");
@@ -1323,17 +2674,24 @@ void SharedMemoryPlugin::UpdateGraphics(GraphicsInfoV02 const& info)
   if (!mIsMapped)
     return;
 
-  DEBUG_MSG(DebugLevel::Timing, DebugSource::Graphics, "GRAPHICS - updated.");
+  // Graphics updates are also requested if only Extrapolation is subscribed to.
+  if (Utils::IsFlagOff(SharedMemoryPlugin::msUnsubscribedBuffersMask, SubscribedBuffer::Graphics)
+    && !IsBufferSuspended(SubscribedBuffer::Graphics)) {
+    DEBUG_MSG(DebugLevel::Timing, DebugSource::Graphics, "GRAPHICS - updated.");
+
+    // Do not version Graphics buffer, as it is asynchronous by the nature anyway.
+    memcpy(&(mGraphics.mpWriteBuff->mGraphicsInfo), &info, sizeof(rF2GraphicsInfo));
+  }
 
-  // Do not version Graphics buffer, as it is asynchronous by the nature anyway.
-  memcpy(&(mGraphics.mpWriteBuff->mGraphicsInfo), &info, sizeof(rF2GraphicsInfo));
+  ExtrapolationUpdate();
 }
 
 
 // Invoked at 100FPS.
 bool SharedMemoryPlugin::AccessPitMenu(PitMenuV01& info)
 {
-  if (!mIsMapped)
+  if (!mIsMapped
+    || IsBufferSuspended(SubscribedBuffer::PitInfo))
     return false;
 
   if (mPitMenuLastCategoryIndex == info.mCategoryIndex
@@ -1361,6 +2719,136 @@ bool SharedMemoryPlugin::AccessPitMenu(PitMenuV01& info)
 }
 
 
+// Case insensitive FNV-1a.
+static unsigned long HashHWControlName(char const* const controlName)
+{
+  auto hash = 2166136261uL;
+  for (auto pCh = controlName; *pCh != '\0'; ++pCh) {
+    hash ^= static_cast<unsigned long>(tolower(static_cast<unsigned char>(*pCh)));
+    hash *= 16777619uL;
+  }
+
+  return hash;
+}
+
+
+static unsigned long HashHWControlPointer(char const* const controlName)
+{
+  auto const value = reinterpret_cast<uintptr_t>(controlName);
+  return static_cast<unsigned long>((value >> 3) ^ (value >> 17));
+}
+
+
+long SharedMemoryPlugin::FindHWControl(char const* const controlName) const
+{
+  static auto const MASK = static_cast<unsigned long>(SharedMemoryPlugin::HWCONTROL_HASH_TABLE_SIZE - 1);
+  for (auto bucket = HashHWControlName(controlName) & MASK;; bucket = (bucket + 1uL) & MASK) {
+    auto const index = mHWControlNameBuckets[bucket];
+    if (index < 0L)
+      return -1L;
+
+    if (_stricmp(controlName, mHWControlNamesState.mControlNames[index]) == 0)
+      return index;
+  }
+}
+
+
+long SharedMemoryPlugin::AddHWControl(char const* const controlName)
+{
+  auto& names = mHWControlNamesState;
+  if (names.mNumControls >= rF2HWControlNames::MAX_HWCONTROLS) {
+    DEBUG_MSG(DebugLevel::Errors, DebugSource::HWControlInput, "HWControl: exceeded maximum of tracked control names, '%s' not tracked.", controlName);
+    return -1L;
+  }
+
+  auto const index = names.mNumControls++;
+  strncpy_s(names.mControlNames[index], controlName, _TRUNCATE);
+
+  // Table is at most quarter full, so there's always an empty bucket.
+  static auto const MASK = static_cast<unsigned long>(SharedMemoryPlugin::HWCONTROL_HASH_TABLE_SIZE - 1);
+  auto bucket = HashHWControlName(names.mControlNames[index]) & MASK;
+  while (mHWControlNameBuckets[bucket] >= 0L)
+    bucket = (bucket + 1uL) & MASK;
+
+  mHWControlNameBuckets[bucket] = index;
+  mHWControlNamesChanged = true;
+
+  DEBUG_MSG(DebugLevel::DevInfo, DebugSource::HWControlInput, "HWControl: learned control name: '%s'  index: %ld", names.mControlNames[index], index);
+
+  return index;
+}
+
+
+// Returns index of the control in mHWControlNamesState, -1 if it could not be tracked.
+long SharedMemoryPlugin::ResolveHWControl(char const* const controlName)
+{
+  static auto const MASK = static_cast<unsigned long>(SharedMemoryPlugin::HWCONTROL_HASH_TABLE_SIZE - 1);
+  auto const learning = mHWControlLearnFramesLeft > 0;
+
+  auto pointerBucket = HashHWControlPointer(controlName) & MASK;
+  if (mHWControlPointersStable) {
+    while (mHWControlPointerKeys[pointerBucket] != nullptr) {
+      if (mHWControlPointerKeys[pointerBucket] == controlName) {
+        if (!learning)
+          return mHWControlPointerBuckets[pointerBucket];
+
+        break;
+      }
+
+      pointerBucket = (pointerBucket + 1uL) & MASK;
+    }
+  }
+
+  // Unknown pointer, or pointers are still being verified.
+  auto index = FindHWControl(controlName);
+  if (index < 0L)
+    index = AddHWControl(controlName);
+
+  if (index < 0L || !mHWControlPointersStable)
+    return index;
+
+  if (mHWControlPointerKeys[pointerBucket] == controlName) {
+    if (mHWControlPointerBuckets[pointerBucket] != index) {
+      DEBUG_MSG(DebugLevel::Warnings, DebugSource::HWControlInput, "HWControl: game reuses control name pointers, resolving controls by name.");
+      mHWControlPointersStable = false;
+    }
+  }
+  else if (mNumHWControlPointers < rF2HWControlNames::MAX_HWCONTROLS) {
+    mHWControlPointerKeys[pointerBucket] = controlName;
+    mHWControlPointerBuckets[pointerBucket] = index;
+    ++mNumHWControlPointers;
+  }
+  else {
+    DEBUG_MSG(DebugLevel::Warnings, DebugSource::HWControlInput, "HWControl: too many control name pointers, resolving controls by name.");
+    mHWControlPointersStable = false;
+  }
+
+  return index;
+}
+
+
+// Invoked once per frame, from HasHardwareInputs.
+void SharedMemoryPlugin::UpdateHWControlNames()
+{
+  if (!mIsMapped)
+    return;
+
+  if (mHWControlLearnFramesLeft > 0)
+    --mHWControlLearnFramesLeft;
+
+  if (!mHWControlNamesChanged)
+    return;
+
+  mHWControlNames.BeginUpdate();
+  memcpy(mHWControlNames.mpWriteBuff, &mHWControlNamesState, sizeof(rF2HWControlNames));
+  mHWControlNames.EndUpdate();
+
+  mHWControlNamesChanged = false;
+
+  DEBUG_MSG(DebugLevel::CriticalInfo, DebugSource::HWControlInput, "HWControl: published %ld control names.", mHWControlNamesState.mNumControls);
+}
+
+
 // Invoked at 100FPS twice for each control (836 times per frame in my test).
 bool SharedMemoryPlugin::CheckHWControl(char const* const controlName, double& fRetVal)
 {
@@ -1370,6 +2858,8 @@ bool SharedMemoryPlugin::CheckHWControl(char const* const controlName, double& f
 
   DEBUG_MSG(DebugLevel::Timing, DebugSource::HWControlInput, "CheckHWControl - invoked for: '%s'", controlName);
 
+  auto const controlIndex = ResolveHWControl(controlName);
+
   // Note that we disable this callback if there's no pending HWControl update.
   // However, game checks if we have input to processs once per frame, so mHWControlInputRequestReceived can still be false after we handled it
   // (until the next HasHardwareInputs() test).
@@ -1378,16 +2868,26 @@ bool SharedMemoryPlugin::CheckHWControl(char const* const controlName, double& f
     return false;
   }
 
-  if (_stricmp(controlName, mHWControl.mReadBuff.mControlName) == 0) {
+  // Command with the name that was not learned (yet) still gets a chance.
+  auto const matched = mHWControlCommandIndex >= 0L
+    ? controlIndex == mHWControlCommandIndex
+    : _stricmp(controlName, mHWControlCommand.mControlName) == 0;
+
+  if (matched) {
     if (Utils::IsFlagOn(SharedMemoryPlugin::msDebugOutputLevel, DebugLevel::DevInfo)) {
-      DEBUG_MSG(DebugLevel::DevInfo, DebugSource::HWControlInput, "CheckHWControl input applied:  '%s'  %1.1f .  Update version: %ld",
-        mHWControl.mReadBuff.mControlName, mHWControl.mReadBuff.mfRetVal, mHWControl.mReadLastVersionUpdateBegin);
+      DEBUG_MSG(DebugLevel::DevInfo, DebugSource::HWControlInput, "CheckHWControl input applied:  '%s'  %1.1f .  Update version: %ld  Queued: '%s'",
+        mHWControlCommand.mControlName, mHWControlCommand.mfRetVal, mHWControl.mReadLastVersionUpdateBegin, mHWControlCommandQueued ? "True" : "False");
     }
 
-    fRetVal = mHWControl.mReadBuff.mfRetVal;
+    fRetVal = mHWControlCommand.mfRetVal;
 
     mHWControlInputRequestReceived = false;
 
+    // Next queued command is picked up on the next frame, because game checks each control more than once per frame,
+    // and the same control pressed and released within one frame would be lost.
+    if (mHWControlCommandQueued)
+      PopQueuedHWControlCommand();
+
     return true;
   }
 
@@ -1403,12 +2903,17 @@ bool SharedMemoryPlugin::AccessWeather(double trackNodeSize, WeatherControlInfoV
  
   DEBUG_MSG(DebugLevel::Timing, DebugSource::Weather, "WEATHER - invoked.");
 
-  mWeather.BeginUpdate();
+  if (!IsBufferSuspended(SubscribedBuffer::Weather)) {
+    mWeather.BeginUpdate();
 
-  mWeather.mpWriteBuff->mTrackNodeSize = trackNodeSize;
-  memcpy(&(mWeather.mpWriteBuff->mWeatherInfo), &info, sizeof(rF2WeatherControlInfo));
+    mWeather.mpWriteBuff->mTrackNodeSize = trackNodeSize;
+    memcpy(&(mWeather.mpWriteBuff->mWeatherInfo), &info, sizeof(rF2WeatherControlInfo));
 
-  mWeather.EndUpdate();
+    mWeather.EndUpdate();
+  }
+
+  if (SharedMemoryPlugin::msEventDrivenInputBuffers)
+    ReadWeatherControl();
 
   if (mWeatherControlInputRequestReceived) {
     memcpy(&info, &(mWeatherControl.mReadBuff.mWeatherInfo), sizeof(WeatherControlInfoV01));
@@ -1461,10 +2966,11 @@ bool SharedMemoryPlugin::GetCustomVariable(long i, CustomVariableV01& var)
     strcpy_s(var.mCaption, "UnsubscribedBuffersMask");
     var.mNumSettings = 1;
 
-    // By default, unsubscribe from the Graphics and Weather buffer updates.
+    // By default, unsubscribe from the Graphics, Weather, Telemetry History, Telemetry Lite, Telemetry Projections, Player Telemetry,
+    // Extrapolation, Event Journal and Derived Timing buffer updates.
     // CC does not need some other buffers either, however it is going to be a headache
     // to explain SH users who rely on them how to configure plugin, so let it be.
-    var.mCurrentSetting = 160;
+    var.mCurrentSetting = 32672;
     return true;
   }
   else if (i == 6) {
@@ -1491,6 +2997,52 @@ bool SharedMemoryPlugin::GetCustomVariable(long i, CustomVariableV01& var)
     var.mCurrentSetting = 1;
     return true;
   }
+  else if (i == 10) {
+    strcpy_s(var.mCaption, "TripleBufferedBuffersMask");
+    var.mNumSettings = 1;
+
+    // Triple buffered layout is not understood by the existing clients, so it is opt-in.
+    var.mCurrentSetting = 0;
+    return true;
+  }
+  else if (i == 11) {
+    strcpy_s(var.mCaption, "UpdateNotificationBuffersMask");
+    var.mNumSettings = 1;
+
+    // Signaling costs a couple of syscalls per update, so it is opt-in.
+    var.mCurrentSetting = 0;
+    return true;
+  }
+  else if (i == 12) {
+    strcpy_s(var.mCaption, "CacheLineIsolatedBuffersMask");
+    var.mNumSettings = 1;
+
+    // Isolated layout moves buffer start, which breaks the existing clients, so it is opt-in.
+    var.mCurrentSetting = 0;
+    return true;
+  }
+  else if (i == 13) {
+    strcpy_s(var.mCaption, "LargePagesBuffersMask");
+    var.mNumSettings = 1;
+
+    // Large pages need "Lock pages in memory" user right, and are locked in RAM, so it is opt-in.
+    var.mCurrentSetting = 0;
+    return true;
+  }
+  else if (i == 14) {
+    strcpy_s(var.mCaption, "SuspendIdleBuffersMask");
+    var.mNumSettings = 1;
+
+    // Clients that do not register in the reader registry would stop receiving updates, so it is opt-in.
+    var.mCurrentSetting = 0;
+    return true;
+  }
+  else if (i == 15) {
+    strcpy_s(var.mCaption, "EventDrivenInputBuffers");
+    var.mNumSettings = 2;
+    var.mCurrentSetting = 0;
+    return true;
+  }
 
   return false;
 }
@@ -1530,6 +3082,45 @@ void SharedMemoryPlugin::AccessCustomVariable(CustomVariableV01& var)
     auto sanitized = min(max(var.mCurrentSetting, 1L), static_cast<long>(DebugSource::All));
     SharedMemoryPlugin::msDebugOutputSource = sanitized;
   }
+  else if (_stricmp(var.mCaption, "TripleBufferedBuffersMask") == 0) {
+    auto sanitized = min(max(var.mCurrentSetting, 0L), static_cast<long>(SubscribedBuffer::All));
+
+    // Force Feedback and Graphics buffers are not versioned, so there's nothing to gain.
+    // Telemetry History and Event Journal are appended to, so they have to stay in a single copy.
+    sanitized &= ~(static_cast<long>(SubscribedBuffer::ForceFeedback) | static_cast<long>(SubscribedBuffer::Graphics)
+      | static_cast<long>(SubscribedBuffer::TelemetryHistory) | static_cast<long>(SubscribedBuffer::EventJournal));
+    SharedMemoryPlugin::msTripleBufferedBuffersMask = sanitized;
+  }
+  else if (_stricmp(var.mCaption, "UpdateNotificationBuffersMask") == 0) {
+    auto sanitized = min(max(var.mCurrentSetting, 0L), static_cast<long>(SubscribedBuffer::All));
+
+    // Force Feedback and Graphics buffers are not versioned, so there's nothing to signal.
+    sanitized &= ~(static_cast<long>(SubscribedBuffer::ForceFeedback) | static_cast<long>(SubscribedBuffer::Graphics));
+    SharedMemoryPlugin::msUpdateNotificationBuffersMask = sanitized;
+  }
+  else if (_stricmp(var.mCaption, "CacheLineIsolatedBuffersMask") == 0) {
+    auto sanitized = min(max(var.mCurrentSetting, 0L), static_cast<long>(SubscribedBuffer::All));
+
+    // Force Feedback and Graphics buffers are not versioned, so nobody polls their version block.
+    sanitized &= ~(static_cast<long>(SubscribedBuffer::ForceFeedback) | static_cast<long>(SubscribedBuffer::Graphics));
+    SharedMemoryPlugin::msCacheLineIsolatedBuffersMask = sanitized;
+  }
+  else if (_stricmp(var.mCaption, "LargePagesBuffersMask") == 0) {
+    auto sanitized = min(max(var.mCurrentSetting, 0L), static_cast<long>(SubscribedBuffer::All));
+
+    // Force Feedback buffer is a single double, wasting a whole large page on it makes no sense.
+    sanitized &= ~static_cast<long>(SubscribedBuffer::ForceFeedback);
+    SharedMemoryPlugin::msLargePagesBuffersMask = sanitized;
+  }
+  else if (_stricmp(var.mCaption, "SuspendIdleBuffersMask") == 0) {
+    auto sanitized = min(max(var.mCurrentSetting, 0L), static_cast<long>(SubscribedBuffer::All));
+
+    // Telemetry and Scoring updates drive the frame tracking, Extended state and input buffers, so they are never suspended.
+    sanitized &= ~(static_cast<long>(SubscribedBuffer::Telemetry) | static_cast<long>(SubscribedBuffer::Scoring));
+    SharedMemoryPlugin::msSuspendIdleBuffersMask = sanitized;
+  }
+  else if (_stricmp(var.mCaption, "EventDrivenInputBuffers") == 0)
+    SharedMemoryPlugin::msEventDrivenInputBuffers = var.mCurrentSetting != 0;
 }
 
 